@@ -0,0 +1,140 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "collections.h"
+#include "bitmap.h"
+#include "simd.h"
+
+//Compares the block kernels at every supported level on the same columns, in row group sized blocks like the
+//table scans, and checks every level finds the same matches as the scalar loops
+#define BENCHMARK_ROWS (1 << 24)
+#define BENCHMARK_BLOCK 4096
+#define BENCHMARK_REPEAT 5
+
+const char* LEVEL_NAMES[] = { "scalar", "sse2", "avx2" };
+const char* OPERATOR_NAMES[] = { "=", ">", ">=", "<", "<=", "!=" };
+
+enum BENCHMARK_TYPE
+{
+    BENCHMARK_INT,
+    BENCHMARK_FLOAT,
+    BENCHMARK_CHAR
+};
+
+long long count_matches(unsigned long long* matches, int word_count)
+{
+    long long count = 0;
+    for(int i = 0; i < word_count; i++)
+    {
+        count += count_word_bits(*(matches + i));
+    }
+
+    return count;
+}
+//Runs one operator over the whole column, returns the matches found and stores the fastest of the repeats in seconds
+long long run_kernel(enum BENCHMARK_TYPE type, void* column, int logic_type, unsigned long long* matches, double* seconds)
+{
+    long long count = 0;
+    *seconds = -1;
+
+    for(int repeat = 0; repeat < BENCHMARK_REPEAT; repeat++)
+    {
+        clock_t start = clock();
+        count = 0;
+
+        for(int block = 0; block < BENCHMARK_ROWS; block += BENCHMARK_BLOCK)
+        {
+            if(type == BENCHMARK_INT)
+            {
+                compare_int_block((int*)column + block, BENCHMARK_BLOCK, 0, logic_type, matches);
+            }
+            else if(type == BENCHMARK_FLOAT)
+            {
+                compare_float_block((float*)column + block, BENCHMARK_BLOCK, 0.5f, logic_type, matches);
+            }
+            else
+            {
+                compare_char_block((char*)column + block, BENCHMARK_BLOCK, 'M', logic_type, matches);
+            }
+            count += count_matches(matches, BENCHMARK_BLOCK / 64);
+        }
+
+        double elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+        if(*seconds < 0 || elapsed < *seconds)
+        {
+            *seconds = elapsed;
+        }
+    }
+
+    return count;
+}
+
+int main()
+{
+    int* int_column = (int*)heapallocate(BENCHMARK_ROWS * sizeof(int));
+    float* float_column = (float*)heapallocate(BENCHMARK_ROWS * sizeof(float));
+    char* char_column = (char*)heapallocate(BENCHMARK_ROWS);
+    unsigned long long* matches = (unsigned long long*)heapallocate(BENCHMARK_BLOCK / 64 * sizeof(unsigned long long));
+
+    srand(5025);
+    for(int i = 0; i < BENCHMARK_ROWS; i++)
+    {
+        *(int_column + i) = rand() % 2001 - 1000;
+        *(float_column + i) = (i % 97 == 0) ? NAN : (float)(rand() % 1000) / 1000.0f;
+        *(char_column + i) = (char)('A' + rand() % 26);
+    }
+
+    enum SIMD_LEVEL supported = get_supported_simd_level();
+    printf("%i rows in blocks of %i, best of %i runs, widest level : %s\n", BENCHMARK_ROWS, BENCHMARK_BLOCK, BENCHMARK_REPEAT, LEVEL_NAMES[supported]);
+
+    const char* type_names[] = { "INT", "FLOAT", "CHAR" };
+    void* columns[] = { int_column, float_column, char_column };
+    int is_valid = 1;
+
+    for(int type = BENCHMARK_INT; type <= BENCHMARK_CHAR; type++)
+    {
+        for(int logic_type = 0; logic_type < 6; logic_type++)
+        {
+            double scalar_seconds = 0;
+            long long scalar_count = 0;
+
+            printf("%-5s %-2s", type_names[type], OPERATOR_NAMES[logic_type]);
+            for(int level = SIMD_SCALAR; level <= (int)supported; level++)
+            {
+                double seconds;
+                set_simd_level((enum SIMD_LEVEL)level);
+                long long count = run_kernel((enum BENCHMARK_TYPE)type, columns[type], logic_type, matches, &seconds);
+
+                if(level == SIMD_SCALAR)
+                {
+                    scalar_seconds = seconds;
+                    scalar_count = count;
+                }
+                else if(count != scalar_count)
+                {
+                    is_valid = 0;
+                }
+
+                double rate = seconds > 0 ? BENCHMARK_ROWS / seconds / 1000000.0 : 0;
+                double speedup = seconds > 0 ? scalar_seconds / seconds : 0;
+                printf(" | %s %8.1f Mrows/s x%4.1f", LEVEL_NAMES[level], rate, speedup);
+            }
+            printf(" | %lli matches\n", scalar_count);
+        }
+    }
+
+    free(int_column);
+    free(float_column);
+    free(char_column);
+    free(matches);
+
+    if(!is_valid)
+    {
+        printf("Kernels disagree with the scalar loops\n");
+        return 1;
+    }
+
+    return 0;
+}
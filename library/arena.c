@@ -0,0 +1,113 @@
+#include "arena.h"
+#include "collections.h"
+#include <string.h>
+#include <stdlib.h>
+
+#define ARENA_ALIGNMENT 16
+
+int align_arena_size(int size)
+{
+    return (size + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+}
+
+arena* allocate_arena(int block_size)
+{
+    arena* memory = (arena*)heapallocate(sizeof(arena));
+    memory->block_size = block_size;
+    memory->blocks = NULL;
+
+    return memory;
+}
+
+//A full block is followed by one twice as large, so a cleared arena soon fits a whole statement in its single block
+void* allocate_arena_memory(arena* memory, int size)
+{
+    if(memory == NULL)
+    {
+        force_exit("Fatal error, allocating from a null arena!\n");
+    }
+
+    size = align_arena_size(size);
+
+    arena_block* block = memory->blocks;
+    if(block == NULL || block->used + size > block->capacity)
+    {
+        int capacity = memory->block_size;
+        if(block != NULL)
+        {
+            capacity = block->capacity * 2;
+        }
+        if(capacity < size)
+        {
+            capacity = size;
+        }
+
+        arena_block* next_block = (arena_block*)heapallocate(align_arena_size(sizeof(arena_block)) + capacity);
+        next_block->next = block;
+        next_block->capacity = capacity;
+        next_block->used = 0;
+
+        memory->blocks = next_block;
+        block = next_block;
+    }
+
+    void* data = (char*)block + align_arena_size(sizeof(arena_block)) + block->used;
+    block->used += size;
+
+    return data;
+}
+
+char* copy_arena_string(arena* memory, const char* from, int size)
+{
+    char* string = (char*)allocate_arena_memory(memory, size + 1);
+    memcpy(string, from, size);
+    *(string + size) = '\0';
+
+    return string;
+}
+
+//Keeps only the newest and largest block
+void clear_arena(arena* memory)
+{
+    if(memory == NULL)
+    {
+        force_exit("Fatal error, atempting to clear null arena!\n");
+    }
+
+    arena_block* block = memory->blocks;
+    if(block == NULL)
+    {
+        return;
+    }
+
+    arena_block* older = block->next;
+    while (older != NULL)
+    {
+        arena_block* next = older->next;
+        free(older);
+
+        older = next;
+    }
+
+    block->next = NULL;
+    block->used = 0;
+}
+
+void free_arena(arena* memory)
+{
+    if(memory == NULL)
+    {
+        force_exit("Fatal error, atempting to free null arena!\n");
+    }
+
+    arena_block* block = memory->blocks;
+    while (block != NULL)
+    {
+        arena_block* next = block->next;
+        free(block);
+
+        block = next;
+    }
+
+    free(memory);
+}
@@ -0,0 +1,23 @@
+#ifndef ARENA
+#define ARENA
+
+//Bump pointer allocator, everything allocated from it is released at once by clear_arena
+typedef struct arena_block
+{
+    struct arena_block* next;
+    int capacity;
+    int used;
+} arena_block;
+typedef struct arena
+{
+    int block_size;
+    struct arena_block* blocks;
+} arena;
+
+arena* allocate_arena(int block_size);
+void* allocate_arena_memory(arena* memory, int size);
+char* copy_arena_string(arena* memory, const char* from, int size);
+void clear_arena(arena* memory);
+void free_arena(arena* memory);
+
+#endif
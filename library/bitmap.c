@@ -0,0 +1,480 @@
+#include "bitmap.h"
+#include <string.h>
+#include <stdlib.h>
+
+int count_word_bits(unsigned long long word)
+{
+    word = word - ((word >> 1) & 0x5555555555555555ull);
+    word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+    word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0full;
+
+    return (int)((word * 0x0101010101010101ull) >> 56);
+}
+
+bitmap* allocate_bitmap()
+{
+    bitmap* set = (bitmap*)heapallocate(sizeof(bitmap));
+    set->containers = allocate_array_list(sizeof(bitmap_container));
+
+    return set;
+}
+
+bitmap_container* get_bitmap_container(bitmap* set, int index)
+{
+    return (bitmap_container*)get_array_list_data(set->containers, index);
+}
+void free_bitmap_container(bitmap_container* container)
+{
+    free(container->values);
+    free(container->words);
+}
+//Index of the container holding key, or -(insert position) - 1 when there is none
+int find_bitmap_container(bitmap* set, int key)
+{
+    int low = 0;
+    int high = set->containers->count - 1;
+
+    while (low <= high)
+    {
+        int middle = (low + high) / 2;
+        int middle_key = get_bitmap_container(set, middle)->key;
+
+        if(middle_key == key)
+        {
+            return middle;
+        }
+        if(middle_key < key)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle - 1;
+        }
+    }
+
+    return -low - 1;
+}
+bitmap_container* insert_bitmap_container(bitmap* set, int index, int key)
+{
+    bitmap_container container;
+    container.key = key;
+    container.cardinality = 0;
+    container.capacity = 0;
+    container.values = NULL;
+    container.words = NULL;
+
+    add_array_list_value(set->containers, &container);
+    memmove(set->containers->data + (index + 1) * sizeof(bitmap_container), set->containers->data + index * sizeof(bitmap_container), (set->containers->count - index - 1) * sizeof(bitmap_container));
+    memcpy(set->containers->data + index * sizeof(bitmap_container), &container, sizeof(bitmap_container));
+
+    return get_bitmap_container(set, index);
+}
+void remove_bitmap_container(bitmap* set, int index)
+{
+    free_bitmap_container(get_bitmap_container(set, index));
+    remove_array_list_value_at(set->containers, index);
+}
+
+//Position of low in a sorted array container, or -(insert position) - 1 when missing
+int find_container_value(bitmap_container* container, unsigned short low)
+{
+    int low_index = 0;
+    int high_index = container->cardinality - 1;
+
+    while (low_index <= high_index)
+    {
+        int middle = (low_index + high_index) / 2;
+        unsigned short value = *(container->values + middle);
+
+        if(value == low)
+        {
+            return middle;
+        }
+        if(value < low)
+        {
+            low_index = middle + 1;
+        }
+        else
+        {
+            high_index = middle - 1;
+        }
+    }
+
+    return -low_index - 1;
+}
+void convert_container_to_words(bitmap_container* container)
+{
+    container->words = (unsigned long long*)heapallocate(BITMAP_CONTAINER_WORDS * sizeof(unsigned long long));
+    memset(container->words, 0, BITMAP_CONTAINER_WORDS * sizeof(unsigned long long));
+
+    for(int i = 0; i < container->cardinality; i++)
+    {
+        unsigned short value = *(container->values + i);
+        *(container->words + (value >> 6)) |= 1ull << (value & 63);
+    }
+
+    free(container->values);
+    container->values = NULL;
+    container->capacity = 0;
+}
+void convert_container_to_array(bitmap_container* container)
+{
+    container->capacity = container->cardinality > 0 ? container->cardinality : 1;
+    container->values = (unsigned short*)heapallocate(container->capacity * sizeof(unsigned short));
+
+    int count = 0;
+    for(int i = 0; i < BITMAP_CONTAINER_WORDS; i++)
+    {
+        unsigned long long word = *(container->words + i);
+        for(int bit = 0; word != 0; bit++, word >>= 1)
+        {
+            if(word & 1)
+            {
+                *(container->values + count++) = (unsigned short)((i << 6) + bit);
+            }
+        }
+    }
+
+    free(container->words);
+    container->words = NULL;
+}
+void recount_container_words(bitmap_container* container)
+{
+    container->cardinality = 0;
+    for(int i = 0; i < BITMAP_CONTAINER_WORDS; i++)
+    {
+        container->cardinality += count_word_bits(*(container->words + i));
+    }
+}
+int has_container_value(bitmap_container* container, unsigned short low)
+{
+    if(container->words != NULL)
+    {
+        return (*(container->words + (low >> 6)) >> (low & 63)) & 1;
+    }
+
+    return find_container_value(container, low) >= 0;
+}
+
+void add_bitmap_value(bitmap* set, int value)
+{
+    int index = find_bitmap_container(set, value >> 16);
+    if(index < 0)
+    {
+        index = -index - 1;
+        insert_bitmap_container(set, index, value >> 16);
+    }
+
+    bitmap_container* container = get_bitmap_container(set, index);
+    unsigned short low = (unsigned short)(value & 0xffff);
+
+    if(container->words == NULL && container->cardinality == BITMAP_ARRAY_LIMIT && find_container_value(container, low) < 0)
+    {
+        convert_container_to_words(container);
+    }
+
+    if(container->words != NULL)
+    {
+        unsigned long long bit = 1ull << (low & 63);
+        if((*(container->words + (low >> 6)) & bit) == 0)
+        {
+            *(container->words + (low >> 6)) |= bit;
+            container->cardinality++;
+        }
+        return;
+    }
+
+    int position = find_container_value(container, low);
+    if(position >= 0)
+    {
+        return;
+    }
+    position = -position - 1;
+
+    if(container->cardinality == container->capacity)
+    {
+        container->capacity = container->capacity == 0 ? 4 : container->capacity * 2;
+        unsigned short* values = (unsigned short*)heapallocate(container->capacity * sizeof(unsigned short));
+        if(container->values != NULL)
+        {
+            memcpy(values, container->values, container->cardinality * sizeof(unsigned short));
+            free(container->values);
+        }
+        container->values = values;
+    }
+
+    memmove(container->values + position + 1, container->values + position, (container->cardinality - position) * sizeof(unsigned short));
+    *(container->values + position) = low;
+    container->cardinality++;
+}
+//Bitsets only go back to arrays once they are half the limit, so values added and removed around it do not convert every time
+void remove_bitmap_value(bitmap* set, int value)
+{
+    int index = find_bitmap_container(set, value >> 16);
+    if(index < 0)
+    {
+        return;
+    }
+
+    bitmap_container* container = get_bitmap_container(set, index);
+    unsigned short low = (unsigned short)(value & 0xffff);
+
+    if(container->words != NULL)
+    {
+        unsigned long long bit = 1ull << (low & 63);
+        if((*(container->words + (low >> 6)) & bit) == 0)
+        {
+            return;
+        }
+        *(container->words + (low >> 6)) &= ~bit;
+        container->cardinality--;
+
+        if(container->cardinality <= BITMAP_ARRAY_LIMIT / 2)
+        {
+            convert_container_to_array(container);
+        }
+    }
+    else
+    {
+        int position = find_container_value(container, low);
+        if(position < 0)
+        {
+            return;
+        }
+        memmove(container->values + position, container->values + position + 1, (container->cardinality - position - 1) * sizeof(unsigned short));
+        container->cardinality--;
+    }
+
+    if(container->cardinality == 0)
+    {
+        remove_bitmap_container(set, index);
+    }
+}
+int has_bitmap_value(bitmap* set, int value)
+{
+    int index = find_bitmap_container(set, value >> 16);
+    if(index < 0)
+    {
+        return 0;
+    }
+
+    return has_container_value(get_bitmap_container(set, index), (unsigned short)(value & 0xffff));
+}
+int get_bitmap_count(bitmap* set)
+{
+    int count = 0;
+    for(int i = 0; i < set->containers->count; i++)
+    {
+        count += get_bitmap_container(set, i)->cardinality;
+    }
+
+    return count;
+}
+
+void copy_bitmap(bitmap* target, bitmap* source)
+{
+    clear_bitmap(target);
+    for(int i = 0; i < source->containers->count; i++)
+    {
+        bitmap_container* source_container = get_bitmap_container(source, i);
+        bitmap_container* container = insert_bitmap_container(target, i, source_container->key);
+
+        container->cardinality = source_container->cardinality;
+        if(source_container->words != NULL)
+        {
+            container->words = (unsigned long long*)heapallocate(BITMAP_CONTAINER_WORDS * sizeof(unsigned long long));
+            memcpy(container->words, source_container->words, BITMAP_CONTAINER_WORDS * sizeof(unsigned long long));
+        }
+        else
+        {
+            container->capacity = source_container->cardinality;
+            container->values = (unsigned short*)heapallocate(container->capacity * sizeof(unsigned short));
+            memcpy(container->values, source_container->values, container->cardinality * sizeof(unsigned short));
+        }
+    }
+}
+
+//Keeps the values of target that source also holds, containers are matched by key and intersected a word or a value at a time
+void and_bitmap(bitmap* target, bitmap* source)
+{
+    int index = 0;
+    while (index < target->containers->count)
+    {
+        bitmap_container* container = get_bitmap_container(target, index);
+        int source_index = find_bitmap_container(source, container->key);
+        if(source_index < 0)
+        {
+            remove_bitmap_container(target, index);
+            continue;
+        }
+
+        bitmap_container* source_container = get_bitmap_container(source, source_index);
+        if(container->words != NULL && source_container->words != NULL)
+        {
+            for(int i = 0; i < BITMAP_CONTAINER_WORDS; i++)
+            {
+                *(container->words + i) &= *(source_container->words + i);
+            }
+            recount_container_words(container);
+
+            if(container->cardinality <= BITMAP_ARRAY_LIMIT / 2)
+            {
+                convert_container_to_array(container);
+            }
+        }
+        else if(container->words != NULL)
+        {
+            //The result is at most as large as the source array, so it is rebuilt as an array
+            unsigned long long* words = container->words;
+            container->words = NULL;
+            container->capacity = source_container->cardinality;
+            container->values = (unsigned short*)heapallocate(container->capacity * sizeof(unsigned short));
+            container->cardinality = 0;
+
+            for(int i = 0; i < source_container->cardinality; i++)
+            {
+                unsigned short low = *(source_container->values + i);
+                if((*(words + (low >> 6)) >> (low & 63)) & 1)
+                {
+                    *(container->values + container->cardinality++) = low;
+                }
+            }
+            free(words);
+        }
+        else
+        {
+            int count = 0;
+            for(int i = 0; i < container->cardinality; i++)
+            {
+                unsigned short low = *(container->values + i);
+                if(has_container_value(source_container, low))
+                {
+                    *(container->values + count++) = low;
+                }
+            }
+            container->cardinality = count;
+        }
+
+        if(container->cardinality == 0)
+        {
+            remove_bitmap_container(target, index);
+            continue;
+        }
+        index++;
+    }
+}
+//Adds every value of source to target
+void or_bitmap(bitmap* target, bitmap* source)
+{
+    for(int i = 0; i < source->containers->count; i++)
+    {
+        bitmap_container* source_container = get_bitmap_container(source, i);
+        int index = find_bitmap_container(target, source_container->key);
+        if(index < 0)
+        {
+            index = -index - 1;
+            insert_bitmap_container(target, index, source_container->key);
+        }
+
+        bitmap_container* container = get_bitmap_container(target, index);
+        if(container->words == NULL && (source_container->words != NULL || container->cardinality + source_container->cardinality > BITMAP_ARRAY_LIMIT))
+        {
+            convert_container_to_words(container);
+        }
+
+        if(container->words != NULL)
+        {
+            if(source_container->words != NULL)
+            {
+                for(int j = 0; j < BITMAP_CONTAINER_WORDS; j++)
+                {
+                    *(container->words + j) |= *(source_container->words + j);
+                }
+            }
+            else
+            {
+                for(int j = 0; j < source_container->cardinality; j++)
+                {
+                    unsigned short low = *(source_container->values + j);
+                    *(container->words + (low >> 6)) |= 1ull << (low & 63);
+                }
+            }
+            recount_container_words(container);
+            continue;
+        }
+
+        //Both sorted arrays are merged into a new one
+        unsigned short* values = (unsigned short*)heapallocate((container->cardinality + source_container->cardinality) * sizeof(unsigned short));
+        int left = 0;
+        int right = 0;
+        int count = 0;
+        while (left < container->cardinality || right < source_container->cardinality)
+        {
+            if(right == source_container->cardinality || (left < container->cardinality && *(container->values + left) < *(source_container->values + right)))
+            {
+                *(values + count++) = *(container->values + left++);
+            }
+            else if(left == container->cardinality || *(source_container->values + right) < *(container->values + left))
+            {
+                *(values + count++) = *(source_container->values + right++);
+            }
+            else
+            {
+                *(values + count++) = *(container->values + left++);
+                right++;
+            }
+        }
+
+        free(container->values);
+        container->values = values;
+        container->capacity = container->cardinality + source_container->cardinality;
+        container->cardinality = count;
+    }
+}
+
+//Appends every value in ascending order
+void get_bitmap_values(bitmap* set, array_list* values)
+{
+    for(int i = 0; i < set->containers->count; i++)
+    {
+        bitmap_container* container = get_bitmap_container(set, i);
+        int high = container->key << 16;
+
+        if(container->words == NULL)
+        {
+            for(int j = 0; j < container->cardinality; j++)
+            {
+                add_array_list_int(values, high + *(container->values + j));
+            }
+            continue;
+        }
+
+        for(int j = 0; j < BITMAP_CONTAINER_WORDS; j++)
+        {
+            unsigned long long word = *(container->words + j);
+            for(int bit = 0; word != 0; bit++, word >>= 1)
+            {
+                if(word & 1)
+                {
+                    add_array_list_int(values, high + (j << 6) + bit);
+                }
+            }
+        }
+    }
+}
+
+void clear_bitmap(bitmap* set)
+{
+    for(int i = 0; i < set->containers->count; i++)
+    {
+        free_bitmap_container(get_bitmap_container(set, i));
+    }
+    clear_array_list(set->containers);
+}
+void free_bitmap(bitmap* set)
+{
+    clear_bitmap(set);
+    free_array_list(set->containers);
+    free(set);
+}
@@ -0,0 +1,38 @@
+#ifndef BITMAP
+#define BITMAP
+
+#include "collections.h"
+
+//Compressed set of non negative ints split into containers of 65536 values by their high bits.
+//Sparse containers keep their low bits as a sorted array, containers with more than BITMAP_ARRAY_LIMIT values
+//switch to a plain bitset
+#define BITMAP_ARRAY_LIMIT 4096
+#define BITMAP_CONTAINER_WORDS 1024
+
+typedef struct bitmap_container
+{
+    int key;
+    int cardinality;
+    int capacity;
+    unsigned short* values;
+    unsigned long long* words;
+} bitmap_container;
+typedef struct bitmap
+{
+    array_list* containers;
+} bitmap;
+
+int count_word_bits(unsigned long long word);
+bitmap* allocate_bitmap();
+void add_bitmap_value(bitmap* set, int value);
+void remove_bitmap_value(bitmap* set, int value);
+int has_bitmap_value(bitmap* set, int value);
+int get_bitmap_count(bitmap* set);
+void copy_bitmap(bitmap* target, bitmap* source);
+void and_bitmap(bitmap* target, bitmap* source);
+void or_bitmap(bitmap* target, bitmap* source);
+void get_bitmap_values(bitmap* set, array_list* values);
+void clear_bitmap(bitmap* set);
+void free_bitmap(bitmap* set);
+
+#endif
@@ -0,0 +1,301 @@
+#include "btree.h"
+#include "collections.h"
+#include <string.h>
+#include <stdlib.h>
+
+//Nodes hold one entry more than the order so a full node can take the entry before being split
+btree_node* allocate_btree_node(btree* tree, int is_leaf)
+{
+    btree_node* node = (btree_node*)heapallocate(sizeof(btree_node));
+    node->is_leaf = is_leaf;
+    node->count = 0;
+    node->keys = (char*)heapallocate(tree->key_size * (BTREE_ORDER + 1));
+    node->values = (int*)heapallocate(sizeof(int) * (BTREE_ORDER + 1));
+    node->children = NULL;
+    node->next = NULL;
+
+    if(!is_leaf)
+    {
+        node->children = (btree_node**)heapallocate(sizeof(btree_node*) * (BTREE_ORDER + 2));
+    }
+
+    return node;
+}
+void free_btree_node(btree_node* node)
+{
+    if(!node->is_leaf)
+    {
+        for(int i = 0; i <= node->count; i++)
+        {
+            free_btree_node(*(node->children + i));
+        }
+        free(node->children);
+    }
+
+    free(node->keys);
+    free(node->values);
+    free(node);
+}
+
+btree* allocate_btree(int key_size, btree_compare compare)
+{
+    btree* tree = (btree*)heapallocate(sizeof(btree));
+    tree->key_size = key_size;
+    tree->count = 0;
+    tree->compare = compare;
+    tree->root = allocate_btree_node(tree, 1);
+
+    return tree;
+}
+
+char* get_btree_node_key(btree* tree, btree_node* node, int index)
+{
+    return node->keys + index * tree->key_size;
+}
+int compare_btree_entry(btree* tree, btree_node* node, int index, const void* key, int value)
+{
+    int compare = tree->compare(get_btree_node_key(tree, node, index), key);
+    if(compare != 0)
+    {
+        return compare;
+    }
+
+    int node_value = *(node->values + index);
+    if(node_value < value)
+    {
+        return -1;
+    }
+    if(node_value > value)
+    {
+        return 1;
+    }
+
+    return 0;
+}
+//Index of the first entry greater than the given one, which is also the child holding it
+int find_btree_upper_bound(btree* tree, btree_node* node, const void* key, int value)
+{
+    int low = 0;
+    int high = node->count;
+
+    while (low < high)
+    {
+        int middle = (low + high) / 2;
+        if(compare_btree_entry(tree, node, middle, key, value) <= 0)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+void insert_btree_entry(btree* tree, btree_node* node, int index, const void* key, int value)
+{
+    memmove(get_btree_node_key(tree, node, index + 1), get_btree_node_key(tree, node, index), (node->count - index) * tree->key_size);
+    memmove(node->values + index + 1, node->values + index, (node->count - index) * sizeof(int));
+
+    memcpy(get_btree_node_key(tree, node, index), key, tree->key_size);
+    *(node->values + index) = value;
+    node->count++;
+}
+
+//Returns the new right sibling when the node had to be split, separator receives the first entry of the right side
+btree_node* insert_btree_node(btree* tree, btree_node* node, const void* key, int value, char* separator_key, int* separator_value)
+{
+    int index = find_btree_upper_bound(tree, node, key, value);
+
+    if(node->is_leaf)
+    {
+        insert_btree_entry(tree, node, index, key, value);
+    }
+    else
+    {
+        btree_node* child = *(node->children + index);
+        btree_node* split = insert_btree_node(tree, child, key, value, separator_key, separator_value);
+        if(split == NULL)
+        {
+            return NULL;
+        }
+
+        memmove(node->children + index + 2, node->children + index + 1, (node->count - index) * sizeof(btree_node*));
+        *(node->children + index + 1) = split;
+        insert_btree_entry(tree, node, index, separator_key, *separator_value);
+    }
+
+    if(node->count <= BTREE_ORDER)
+    {
+        return NULL;
+    }
+
+    int middle = node->count / 2;
+    btree_node* right = allocate_btree_node(tree, node->is_leaf);
+
+    if(node->is_leaf)
+    {
+        right->count = node->count - middle;
+        memcpy(right->keys, get_btree_node_key(tree, node, middle), right->count * tree->key_size);
+        memcpy(right->values, node->values + middle, right->count * sizeof(int));
+
+        right->next = node->next;
+        node->next = right;
+        node->count = middle;
+
+        memcpy(separator_key, right->keys, tree->key_size);
+        *separator_value = *(right->values);
+    }
+    else
+    {
+        //The middle entry moves up instead of staying in either side
+        right->count = node->count - middle - 1;
+        memcpy(right->keys, get_btree_node_key(tree, node, middle + 1), right->count * tree->key_size);
+        memcpy(right->values, node->values + middle + 1, right->count * sizeof(int));
+        memcpy(right->children, node->children + middle + 1, (right->count + 1) * sizeof(btree_node*));
+
+        memcpy(separator_key, get_btree_node_key(tree, node, middle), tree->key_size);
+        *separator_value = *(node->values + middle);
+        node->count = middle;
+    }
+
+    return right;
+}
+
+void insert_btree_value(btree* tree, const void* key, int value)
+{
+    char* separator_key = (char*)heapallocate(tree->key_size);
+    int separator_value;
+
+    btree_node* split = insert_btree_node(tree, tree->root, key, value, separator_key, &separator_value);
+    if(split != NULL)
+    {
+        btree_node* root = allocate_btree_node(tree, 0);
+        memcpy(root->keys, separator_key, tree->key_size);
+        *(root->values) = separator_value;
+        *(root->children) = tree->root;
+        *(root->children + 1) = split;
+        root->count = 1;
+
+        tree->root = root;
+    }
+
+    free(separator_key);
+    tree->count++;
+}
+
+int remove_btree_value(btree* tree, const void* key, int value)
+{
+    btree_node* node = tree->root;
+    while (!node->is_leaf)
+    {
+        node = *(node->children + find_btree_upper_bound(tree, node, key, value));
+    }
+
+    int index = find_btree_upper_bound(tree, node, key, value) - 1;
+    if(index < 0 || compare_btree_entry(tree, node, index, key, value) != 0)
+    {
+        return 0;
+    }
+
+    memmove(get_btree_node_key(tree, node, index), get_btree_node_key(tree, node, index + 1), (node->count - index - 1) * tree->key_size);
+    memmove(node->values + index, node->values + index + 1, (node->count - index - 1) * sizeof(int));
+    node->count--;
+    tree->count--;
+
+    return 1;
+}
+
+void clear_btree(btree* tree)
+{
+    free_btree_node(tree->root);
+    tree->root = allocate_btree_node(tree, 1);
+    tree->count = 0;
+}
+void free_btree(btree* tree)
+{
+    free_btree_node(tree->root);
+    free(tree);
+}
+
+//Moves past the end of emptied leaves
+void skip_btree_empty_leaves(btree_iterator* iterator)
+{
+    while (iterator->node != NULL && iterator->index >= iterator->node->count)
+    {
+        iterator->node = iterator->node->next;
+        iterator->index = 0;
+    }
+}
+
+btree_iterator get_btree_first(btree* tree)
+{
+    btree_node* node = tree->root;
+    while (!node->is_leaf)
+    {
+        node = *(node->children);
+    }
+
+    btree_iterator iterator;
+    iterator.key_size = tree->key_size;
+    iterator.node = node;
+    iterator.index = 0;
+    skip_btree_empty_leaves(&iterator);
+
+    return iterator;
+}
+//First entry whose key is not less than the given key
+btree_iterator get_btree_lower_bound(btree* tree, const void* key)
+{
+    btree_node* node = tree->root;
+    while (1)
+    {
+        int low = 0;
+        int high = node->count;
+
+        while (low < high)
+        {
+            int middle = (low + high) / 2;
+            if(tree->compare(get_btree_node_key(tree, node, middle), key) < 0)
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+
+        if(node->is_leaf)
+        {
+            btree_iterator iterator;
+            iterator.key_size = tree->key_size;
+            iterator.node = node;
+            iterator.index = low;
+            skip_btree_empty_leaves(&iterator);
+
+            return iterator;
+        }
+
+        node = *(node->children + low);
+    }
+}
+int is_btree_iterator_end(btree_iterator* iterator)
+{
+    return iterator->node == NULL;
+}
+void next_btree_iterator(btree_iterator* iterator)
+{
+    iterator->index++;
+    skip_btree_empty_leaves(iterator);
+}
+void* get_btree_iterator_key(btree_iterator* iterator)
+{
+    return iterator->node->keys + iterator->index * iterator->key_size;
+}
+int get_btree_iterator_value(btree_iterator* iterator)
+{
+    return *(iterator->node->values + iterator->index);
+}
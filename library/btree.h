@@ -0,0 +1,47 @@
+#ifndef BTREE
+#define BTREE
+
+//Ordered multimap from fixed size keys to int values. Entries are ordered by key then by value, so equal keys
+//are allowed and every entry can still be found exactly. Removing only takes entries out of their leaf, leaves
+//are never merged back
+#define BTREE_ORDER 64
+
+typedef int (*btree_compare)(const void* left, const void* right);
+
+typedef struct btree_node
+{
+    int is_leaf;
+    int count;
+    char* keys;
+    int* values;
+    struct btree_node** children;
+    struct btree_node* next;
+} btree_node;
+typedef struct btree
+{
+    int key_size;
+    int count;
+    btree_compare compare;
+    struct btree_node* root;
+} btree;
+typedef struct btree_iterator
+{
+    int key_size;
+    struct btree_node* node;
+    int index;
+} btree_iterator;
+
+btree* allocate_btree(int key_size, btree_compare compare);
+void insert_btree_value(btree* tree, const void* key, int value);
+int remove_btree_value(btree* tree, const void* key, int value);
+void clear_btree(btree* tree);
+void free_btree(btree* tree);
+
+btree_iterator get_btree_first(btree* tree);
+btree_iterator get_btree_lower_bound(btree* tree, const void* key);
+int is_btree_iterator_end(btree_iterator* iterator);
+void next_btree_iterator(btree_iterator* iterator);
+void* get_btree_iterator_key(btree_iterator* iterator);
+int get_btree_iterator_value(btree_iterator* iterator);
+
+#endif
@@ -41,16 +41,70 @@ void* heapallocate(int size)
     return memory;
 }
 
+#define LINKED_LIST_ALIGNMENT 16
+#define LINKED_LIST_MIN_SLAB 4
+#define LINKED_LIST_MAX_SLAB 1024
+
+int align_linked_list_size(int size)
+{
+    return (size + LINKED_LIST_ALIGNMENT - 1) & ~(LINKED_LIST_ALIGNMENT - 1);
+}
+
 struct linked_list* allocate_linked_list(int data_size)
 {
     struct linked_list* list = (struct linked_list*)heapallocate(sizeof(struct linked_list));
     list->count = 0;
     list->data_size = data_size;
+    list->node_size = align_linked_list_size(sizeof(struct linked_list_node)) + align_linked_list_size(data_size);
     list->head = NULL;
+    list->tail = NULL;
+    list->free_nodes = NULL;
+    list->slabs = NULL;
 
     return list;
 }
 
+//Takes a node from the free list, or from the newest slab, allocating a slab twice as large when it is full
+struct linked_list_node* allocate_linked_list_node(struct linked_list* list)
+{
+    struct linked_list_node* node = list->free_nodes;
+
+    if(node != NULL)
+    {
+        list->free_nodes = node->next;
+        return node;
+    }
+
+    struct linked_list_slab* slab = list->slabs;
+    if(slab == NULL || slab->used == slab->capacity)
+    {
+        int capacity = LINKED_LIST_MIN_SLAB;
+        if(slab != NULL)
+        {
+            capacity = minimum(slab->capacity * 2, LINKED_LIST_MAX_SLAB);
+        }
+
+        struct linked_list_slab* next_slab = (struct linked_list_slab*)heapallocate(align_linked_list_size(sizeof(struct linked_list_slab)) + capacity * list->node_size);
+        next_slab->next = slab;
+        next_slab->capacity = capacity;
+        next_slab->used = 0;
+
+        list->slabs = next_slab;
+        slab = next_slab;
+    }
+
+    node = (struct linked_list_node*)((char*)slab + align_linked_list_size(sizeof(struct linked_list_slab)) + slab->used * list->node_size);
+    node->data = (char*)node + align_linked_list_size(sizeof(struct linked_list_node));
+    slab->used++;
+
+    return node;
+}
+void free_linked_list_node(struct linked_list* list, struct linked_list_node* node)
+{
+    node->next = list->free_nodes;
+    list->free_nodes = node;
+}
+
 void add_linked_list_value(struct linked_list* list, void* data)
 {
     if(list == NULL)
@@ -62,11 +116,8 @@ void add_linked_list_value(struct linked_list* list, void* data)
         force_exit("Fatal error, adding null value to linked list!\n");
     }
 
-    void* copy_data = heapallocate(list->data_size);
-    memcpy(copy_data, data, list->data_size);
-
-    struct linked_list_node* node = (struct linked_list_node*)heapallocate(sizeof(struct linked_list_node));
-    node->data = copy_data;
+    struct linked_list_node* node = allocate_linked_list_node(list);
+    memcpy(node->data, data, list->data_size);
     node->next = NULL;
 
     if(list->count == 0)
@@ -136,15 +187,13 @@ void remove_linked_list_value_at(struct linked_list* list, int index)
         {
             list->tail = NULL;
         }
-        free(current->data);
-        free(current);
+        free_linked_list_node(list, current);
         
         return;
     }
     if(current->next == NULL)
     {
-        free(current->data);
-        free(current);
+        free_linked_list_node(list, current);
         before->next = NULL;
         list->tail = before;
 
@@ -152,8 +201,7 @@ void remove_linked_list_value_at(struct linked_list* list, int index)
     }
 
     linked_list_node* next = current->next;
-    free(current->data);
-    free(current);
+    free_linked_list_node(list, current);
 
     before->next = next;
 }
@@ -187,14 +235,13 @@ void free_linked_list(struct linked_list* list)
         force_exit("Fatal error, atempting to free null list!\n");
     }
 
-    struct linked_list_node* start = list->head;
-    while (start != NULL)
+    struct linked_list_slab* slab = list->slabs;
+    while (slab != NULL)
     {
-        struct linked_list_node* next = start->next;
-        free(start->data);
-        free(start);
+        struct linked_list_slab* next = slab->next;
+        free(slab);
 
-        start = next;
+        slab = next;
     }
     
     free(list);
@@ -207,18 +254,24 @@ void clear_linked_list(linked_list* list)
         force_exit("Fatal error, atempting to clear null list!\n");
     }
 
-    linked_list_node* head = list->head;
-    while (head != NULL)
+    //Only the newest and largest slab is kept for the values added next
+    linked_list_slab* slab = list->slabs;
+    if(slab != NULL)
     {
-        free(head->data);
-        
-        linked_list_node* next = head->next;
+        linked_list_slab* older = slab->next;
+        while (older != NULL)
+        {
+            linked_list_slab* next = older->next;
+            free(older);
 
-        free(head);
+            older = next;
+        }
 
-        head = next;
+        slab->next = NULL;
+        slab->used = 0;
     }
     
+    list->free_nodes = NULL;
     list->count = 0;
     list->head = NULL;
     list->tail = NULL;
@@ -402,4 +455,475 @@ char* get_linked_list_data_string(linked_list* list, int index)
     char* string = (char*)data;
 
     return string;
-}
\ No newline at end of file
+}
+
+//Array List
+struct array_list* allocate_array_list(int data_size)
+{
+    struct array_list* list = (struct array_list*)heapallocate(sizeof(struct array_list));
+    list->data_size = data_size;
+    list->count = 0;
+    list->capacity = 0;
+    list->data = NULL;
+
+    return list;
+}
+
+void reserve_array_list(array_list* list, int capacity)
+{
+    if(list == NULL)
+    {
+        force_exit("Fatal error, atempting to reserve null array list!\n");
+    }
+    if(capacity <= list->capacity)
+    {
+        return;
+    }
+
+    char* data = (char*)realloc(list->data, (size_t)capacity * list->data_size);
+    if(data == NULL)
+    {
+        force_exit("Failed to grow array list memory!\n");
+    }
+
+    list->data = data;
+    list->capacity = capacity;
+}
+
+void grow_array_list(array_list* list)
+{
+    if(list->count < list->capacity)
+    {
+        return;
+    }
+
+    //Amortized doubling, so appending n values only copies O(n) bytes in total
+    int capacity = list->capacity * 2;
+    if(capacity < 8)
+    {
+        capacity = 8;
+    }
+    reserve_array_list(list, capacity);
+}
+
+void add_array_list_value(array_list* list, void* data)
+{
+    if(list == NULL)
+    {
+        force_exit("Fatal error, adding a value to a null array list!\n");
+    }
+    if(data == NULL)
+    {
+        force_exit("Fatal error, adding null value to array list!\n");
+    }
+
+    grow_array_list(list);
+
+    memcpy(list->data + (size_t)list->count * list->data_size, data, list->data_size);
+    list->count = list->count + 1;
+}
+
+void set_array_list_value_at(array_list* list, int index, void* data)
+{
+    if(list == NULL)
+    {
+        force_exit("Fatal error, atempting to set value on null array list!\n");
+    }
+    if(index >= list->count || index < 0)
+    {
+        force_exit("Fatal error, index is out of bounds of array list set value!\n");
+    }
+
+    memcpy(list->data + (size_t)index * list->data_size, data, list->data_size);
+}
+
+void remove_array_list_value_at(array_list* list, int index)
+{
+    if(list == NULL)
+    {
+        force_exit("Fatal error, atempting to remove value on null array list!\n");
+    }
+    if(index >= list->count || index < 0)
+    {
+        force_exit("Fatal error, index is out of bounds of array list remove value!\n");
+    }
+
+    char* at = list->data + (size_t)index * list->data_size;
+    memmove(at, at + list->data_size, (size_t)(list->count - index - 1) * list->data_size);
+
+    list->count = list->count - 1;
+}
+
+void* get_array_list_data(array_list* list, int index)
+{
+    if(list == NULL)
+    {
+        force_exit("Fatal error, atempting to access null array list!\n");
+    }
+    if(index >= list->count || index < 0)
+    {
+        force_exit("Fatal error, index is out of bounds of array list!\n");
+    }
+
+    return list->data + (size_t)index * list->data_size;
+}
+
+void free_array_list(array_list* list)
+{
+    if(list == NULL)
+    {
+        force_exit("Fatal error, atempting to free null array list!\n");
+    }
+
+    free(list->data);
+    free(list);
+}
+
+void clear_array_list(array_list* list)
+{
+    if(list == NULL)
+    {
+        force_exit("Fatal error, atempting to clear null array list!\n");
+    }
+
+    list->count = 0;
+}
+
+//int
+void add_array_list_int(array_list* list, int val)
+{
+    if(list == NULL)
+    {
+        force_exit("Fatal error, atempting to access null array list!\n");
+    }
+    if(list->data_size != sizeof(int))
+    {
+        force_exit("Fatal error, incorrect array list data size for int!\n");
+    }
+    add_array_list_value(list, &val);
+}
+void set_array_list_value_int_at(array_list* list, int index, int value)
+{
+    if(list == NULL)
+    {
+        force_exit("Fatal error, atempting to access null array list!\n");
+    }
+    if(list->data_size != sizeof(int))
+    {
+        force_exit("Fatal error, incorrect array list data size for int!\n");
+    }
+    set_array_list_value_at(list, index, &value);
+}
+int get_array_list_data_int(array_list* list, int index)
+{
+    void* data = get_array_list_data(list, index);
+
+    if(list->data_size != sizeof(int))
+    {
+        force_exit("Fatal error, incorrect array list data size for int!\n");
+    }
+
+    return *((int*)data);
+}
+
+//float
+void add_array_list_float(array_list* list, float val)
+{
+    if(list == NULL)
+    {
+        force_exit("Fatal error, atempting to access null array list!\n");
+    }
+    if(list->data_size != sizeof(float))
+    {
+        force_exit("Fatal error, incorrect array list data size for float!\n");
+    }
+    add_array_list_value(list, &val);
+}
+void set_array_list_value_float_at(array_list* list, int index, float value)
+{
+    if(list == NULL)
+    {
+        force_exit("Fatal error, atempting to access null array list!\n");
+    }
+    if(list->data_size != sizeof(float))
+    {
+        force_exit("Fatal error, incorrect array list data size for float!\n");
+    }
+    set_array_list_value_at(list, index, &value);
+}
+float get_array_list_data_float(array_list* list, int index)
+{
+    void* data = get_array_list_data(list, index);
+
+    if(list->data_size != sizeof(float))
+    {
+        force_exit("Fatal error, incorrect array list data size for float!\n");
+    }
+
+    return *((float*)data);
+}
+
+//char
+void add_array_list_char(array_list* list, char val)
+{
+    if(list == NULL)
+    {
+        force_exit("Fatal error, atempting to access null array list!\n");
+    }
+    if(list->data_size != sizeof(char))
+    {
+        force_exit("Fatal error, incorrect array list data size for char!\n");
+    }
+    add_array_list_value(list, &val);
+}
+void set_array_list_value_char_at(array_list* list, int index, char value)
+{
+    if(list == NULL)
+    {
+        force_exit("Fatal error, atempting to access null array list!\n");
+    }
+    if(list->data_size != sizeof(char))
+    {
+        force_exit("Fatal error, incorrect array list data size for char!\n");
+    }
+    set_array_list_value_at(list, index, &value);
+}
+char get_array_list_data_char(array_list* list, int index)
+{
+    void* data = get_array_list_data(list, index);
+
+    if(list->data_size != sizeof(char))
+    {
+        force_exit("Fatal error, incorrect array list data size for char!\n");
+    }
+
+    return *((char*)data);
+}
+
+//string
+void add_array_list_string_safe(array_list* list, char* val)
+{
+    if(list == NULL)
+    {
+        force_exit("Fatal error, atempting to access null array list!\n");
+    }
+    grow_array_list(list);
+
+    //Copy straight into the slot, a fixed width string never needs a temporary buffer
+    char* slot = list->data + (size_t)list->count * list->data_size;
+    int len = minimum(strlen(val), list->data_size - 1);
+
+    memcpy(slot, val, len);
+    memset(slot + len, 0, list->data_size - len);
+
+    list->count = list->count + 1;
+}
+void set_array_list_value_string_at_safe(array_list* list, int index, char* value)
+{
+    char* slot = (char*)get_array_list_data(list, index);
+    int len = minimum(strlen(value), list->data_size - 1);
+
+    memcpy(slot, value, len);
+    memset(slot + len, 0, list->data_size - len);
+}
+char* get_array_list_data_string(array_list* list, int index)
+{
+    return (char*)get_array_list_data(list, index);
+}
+
+
+//Hash Map
+//Open addressing with linear probing, every key is copied right after its data in a single block
+unsigned int hash_bytes(const void* key, int key_size)
+{
+    const unsigned char* bytes = (const unsigned char*)key;
+    unsigned int hash = 2166136261u;
+
+    for(int i = 0; i < key_size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+struct hash_map* allocate_hash_map(int data_size)
+{
+    struct hash_map* map = (struct hash_map*)heapallocate(sizeof(struct hash_map));
+    map->data_size = data_size;
+    map->count = 0;
+    map->capacity = 16;
+    map->entries = (hash_map_entry*)heapallocate(sizeof(hash_map_entry) * map->capacity);
+    memset(map->entries, 0, sizeof(hash_map_entry) * map->capacity);
+
+    return map;
+}
+
+int find_hash_map_slot(hash_map* map, const void* key, int key_size, unsigned int hash)
+{
+    int mask = map->capacity - 1;
+    int slot = hash & mask;
+
+    while ((map->entries + slot)->block != NULL)
+    {
+        hash_map_entry* entry = map->entries + slot;
+        if(entry->hash == hash && entry->key_size == key_size && memcmp(entry->block + map->data_size, key, key_size) == 0)
+        {
+            return slot;
+        }
+
+        slot = (slot + 1) & mask;
+    }
+
+    return slot;
+}
+
+void grow_hash_map(hash_map* map)
+{
+    int old_capacity = map->capacity;
+    hash_map_entry* old_entries = map->entries;
+
+    map->capacity = old_capacity * 2;
+    map->entries = (hash_map_entry*)heapallocate(sizeof(hash_map_entry) * map->capacity);
+    memset(map->entries, 0, sizeof(hash_map_entry) * map->capacity);
+
+    int mask = map->capacity - 1;
+    for(int i = 0; i < old_capacity; i++)
+    {
+        hash_map_entry* entry = old_entries + i;
+        if(entry->block == NULL)
+        {
+            continue;
+        }
+
+        int slot = entry->hash & mask;
+        while ((map->entries + slot)->block != NULL)
+        {
+            slot = (slot + 1) & mask;
+        }
+        *(map->entries + slot) = *entry;
+    }
+
+    free(old_entries);
+}
+
+void* get_hash_map_data(hash_map* map, const void* key, int key_size)
+{
+    if(map == NULL)
+    {
+        force_exit("Fatal error, atempting to access null hash map!\n");
+    }
+
+    int slot = find_hash_map_slot(map, key, key_size, hash_bytes(key, key_size));
+
+    return (map->entries + slot)->block;
+}
+
+void* put_hash_map_value(hash_map* map, const void* key, int key_size, void* data)
+{
+    if(map == NULL)
+    {
+        force_exit("Fatal error, adding a value to a null hash map!\n");
+    }
+    if(data == NULL)
+    {
+        force_exit("Fatal error, adding null value to hash map!\n");
+    }
+
+    unsigned int hash = hash_bytes(key, key_size);
+    int slot = find_hash_map_slot(map, key, key_size, hash);
+    hash_map_entry* entry = map->entries + slot;
+
+    if(entry->block != NULL)
+    {
+        memcpy(entry->block, data, map->data_size);
+        return entry->block;
+    }
+
+    if((map->count + 1) * 4 > map->capacity * 3)
+    {
+        grow_hash_map(map);
+        slot = find_hash_map_slot(map, key, key_size, hash);
+        entry = map->entries + slot;
+    }
+
+    entry->hash = hash;
+    entry->key_size = key_size;
+    entry->block = (char*)heapallocate(map->data_size + key_size);
+    memcpy(entry->block, data, map->data_size);
+    memcpy(entry->block + map->data_size, key, key_size);
+
+    map->count = map->count + 1;
+
+    return entry->block;
+}
+
+int remove_hash_map_value(hash_map* map, const void* key, int key_size)
+{
+    if(map == NULL)
+    {
+        force_exit("Fatal error, atempting to remove value on null hash map!\n");
+    }
+
+    int mask = map->capacity - 1;
+    int slot = find_hash_map_slot(map, key, key_size, hash_bytes(key, key_size));
+
+    if((map->entries + slot)->block == NULL)
+    {
+        return 0;
+    }
+
+    free((map->entries + slot)->block);
+    (map->entries + slot)->block = NULL;
+    map->count = map->count - 1;
+
+    //Shift the following entries of the probe chain back so lookups never stop at the hole
+    int hole = slot;
+    int next = (slot + 1) & mask;
+    while ((map->entries + next)->block != NULL)
+    {
+        int home = (map->entries + next)->hash & mask;
+        if(((next - home) & mask) >= ((next - hole) & mask))
+        {
+            *(map->entries + hole) = *(map->entries + next);
+            (map->entries + next)->block = NULL;
+            hole = next;
+        }
+
+        next = (next + 1) & mask;
+    }
+
+    return 1;
+}
+
+void free_hash_map(hash_map* map)
+{
+    if(map == NULL)
+    {
+        force_exit("Fatal error, atempting to free null hash map!\n");
+    }
+
+    clear_hash_map(map);
+    free(map->entries);
+    free(map);
+}
+
+void clear_hash_map(hash_map* map)
+{
+    if(map == NULL)
+    {
+        force_exit("Fatal error, atempting to clear null hash map!\n");
+    }
+
+    for(int i = 0; i < map->capacity; i++)
+    {
+        if((map->entries + i)->block != NULL)
+        {
+            free((map->entries + i)->block);
+            (map->entries + i)->block = NULL;
+        }
+    }
+
+    map->count = 0;
+}
@@ -6,14 +6,45 @@ typedef struct linked_list_node
     void* data;
     struct linked_list_node* next;
 } linked_list_node;
+//Nodes are carved out of slabs with their data stored right after them, removed nodes go to a free list
+typedef struct linked_list_slab
+{
+    struct linked_list_slab* next;
+    int capacity;
+    int used;
+} linked_list_slab;
 typedef struct linked_list
 {
     int data_size;
     int count;
+    int node_size;
     struct linked_list_node* head;
     struct linked_list_node* tail;
+    struct linked_list_node* free_nodes;
+    struct linked_list_slab* slabs;
 } linked_list;
+typedef struct array_list
+{
+    int data_size;
+    int count;
+    int capacity;
+    char* data;
+} array_list;
+typedef struct hash_map_entry
+{
+    unsigned int hash;
+    int key_size;
+    char* block;
+} hash_map_entry;
+typedef struct hash_map
+{
+    int data_size;
+    int count;
+    int capacity;
+    struct hash_map_entry* entries;
+} hash_map;
 
+void force_exit(const char* message);
 void* stackheapallocate(int size);
 void* heapallocate(int size);
 
@@ -43,4 +74,37 @@ void set_linked_list_value_string_at(linked_list* list, int index, char* value);
 void set_linked_list_value_string_at_safe(linked_list* list, int index, char* value);
 char* get_linked_list_data_string(linked_list* list, int index);
 
+struct array_list* allocate_array_list(int data_size);
+void reserve_array_list(array_list* list, int capacity);
+void add_array_list_value(array_list* list, void* data);
+void set_array_list_value_at(array_list* list, int index, void* data);
+void remove_array_list_value_at(array_list* list, int index);
+void* get_array_list_data(array_list* list, int index);
+void free_array_list(array_list* list);
+void clear_array_list(array_list* list);
+
+void add_array_list_int(array_list* list, int val);
+void set_array_list_value_int_at(array_list* list, int index, int value);
+int get_array_list_data_int(array_list* list, int index);
+
+void add_array_list_float(array_list* list, float val);
+void set_array_list_value_float_at(array_list* list, int index, float value);
+float get_array_list_data_float(array_list* list, int index);
+
+void add_array_list_char(array_list* list, char val);
+void set_array_list_value_char_at(array_list* list, int index, char value);
+char get_array_list_data_char(array_list* list, int index);
+
+void add_array_list_string_safe(array_list* list, char* val);
+void set_array_list_value_string_at_safe(array_list* list, int index, char* value);
+char* get_array_list_data_string(array_list* list, int index);
+
+unsigned int hash_bytes(const void* key, int key_size);
+struct hash_map* allocate_hash_map(int data_size);
+void* get_hash_map_data(hash_map* map, const void* key, int key_size);
+void* put_hash_map_value(hash_map* map, const void* key, int key_size, void* data);
+int remove_hash_map_value(hash_map* map, const void* key, int key_size);
+void free_hash_map(hash_map* map);
+void clear_hash_map(hash_map* map);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,394 @@
+#include "simd.h"
+#include <string.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SIMD_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define SIMD_TARGET_AVX2
+#else
+#include <cpuid.h>
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+enum SIMD_LEVEL simd_level = SIMD_SCALAR;
+int is_simd_level_set = 0;
+
+//Scalar
+int is_int_match(int value, int constant, int logic_type)
+{
+    switch (logic_type)
+    {
+    case 0:
+        return value == constant;
+    case 1:
+        return value > constant;
+    case 2:
+        return value >= constant;
+    case 3:
+        return value < constant;
+    case 4:
+        return value <= constant;
+    }
+    return value != constant;
+}
+int is_float_match(float value, float constant, int logic_type)
+{
+    switch (logic_type)
+    {
+    case 0:
+        return value == constant;
+    case 1:
+        return value > constant;
+    case 2:
+        return value >= constant;
+    case 3:
+        return value < constant;
+    case 4:
+        return value <= constant;
+    }
+    return value != constant;
+}
+
+//Values from start on are tested one by one, used for whole blocks by the scalar level and for the tail by the others
+void compare_int_scalar(const int* values, int start, int count, int constant, int logic_type, unsigned long long* matches)
+{
+    for(int i = start; i < count; i++)
+    {
+        *(matches + (i >> 6)) |= (unsigned long long)is_int_match(*(values + i), constant, logic_type) << (i & 63);
+    }
+}
+void compare_float_scalar(const float* values, int start, int count, float constant, int logic_type, unsigned long long* matches)
+{
+    for(int i = start; i < count; i++)
+    {
+        *(matches + (i >> 6)) |= (unsigned long long)is_float_match(*(values + i), constant, logic_type) << (i & 63);
+    }
+}
+void compare_char_scalar(const char* values, int start, int count, char constant, int logic_type, unsigned long long* matches)
+{
+    for(int i = start; i < count; i++)
+    {
+        *(matches + (i >> 6)) |= (unsigned long long)is_int_match(*(values + i), constant, logic_type) << (i & 63);
+    }
+}
+
+#ifdef SIMD_X86
+//Each pass fills a whole match word from registers, the values past the last full word go through the scalar loop.
+//Integer compares only come as equal and greater than, the other operators swap the operands or invert the mask.
+//Inverted masks are flipped with the movemask bits, which only hold lanes that exist
+static inline int get_int_mask_sse2(__m128i values, __m128i constant, int logic_type)
+{
+    switch (logic_type)
+    {
+    case 0:
+        return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(values, constant)));
+    case 1:
+        return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(values, constant)));
+    case 2:
+        return ~_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(constant, values))) & 0xf;
+    case 3:
+        return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(constant, values)));
+    case 4:
+        return ~_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(values, constant))) & 0xf;
+    }
+    return ~_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(values, constant))) & 0xf;
+}
+void compare_int_sse2(const int* values, int count, int constant, int logic_type, unsigned long long* matches)
+{
+    __m128i constants = _mm_set1_epi32(constant);
+    int i = 0;
+
+    for(; i + 64 <= count; i += 64)
+    {
+        unsigned long long word = 0;
+        for(int lane = 0; lane < 64; lane += 4)
+        {
+            word |= (unsigned long long)get_int_mask_sse2(_mm_loadu_si128((const __m128i*)(values + i + lane)), constants, logic_type) << lane;
+        }
+        *(matches + (i >> 6)) = word;
+    }
+    compare_int_scalar(values, i, count, constant, logic_type, matches);
+}
+static inline int get_float_mask_sse2(__m128 values, __m128 constant, int logic_type)
+{
+    switch (logic_type)
+    {
+    case 0:
+        return _mm_movemask_ps(_mm_cmpeq_ps(values, constant));
+    case 1:
+        return _mm_movemask_ps(_mm_cmpgt_ps(values, constant));
+    case 2:
+        return _mm_movemask_ps(_mm_cmpge_ps(values, constant));
+    case 3:
+        return _mm_movemask_ps(_mm_cmplt_ps(values, constant));
+    case 4:
+        return _mm_movemask_ps(_mm_cmple_ps(values, constant));
+    }
+    return _mm_movemask_ps(_mm_cmpneq_ps(values, constant));
+}
+void compare_float_sse2(const float* values, int count, float constant, int logic_type, unsigned long long* matches)
+{
+    __m128 constants = _mm_set1_ps(constant);
+    int i = 0;
+
+    for(; i + 64 <= count; i += 64)
+    {
+        unsigned long long word = 0;
+        for(int lane = 0; lane < 64; lane += 4)
+        {
+            word |= (unsigned long long)get_float_mask_sse2(_mm_loadu_ps(values + i + lane), constants, logic_type) << lane;
+        }
+        *(matches + (i >> 6)) = word;
+    }
+    compare_float_scalar(values, i, count, constant, logic_type, matches);
+}
+static inline int get_char_mask_sse2(__m128i values, __m128i constant, int logic_type)
+{
+    switch (logic_type)
+    {
+    case 0:
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(values, constant));
+    case 1:
+        return _mm_movemask_epi8(_mm_cmpgt_epi8(values, constant));
+    case 2:
+        return ~_mm_movemask_epi8(_mm_cmpgt_epi8(constant, values)) & 0xffff;
+    case 3:
+        return _mm_movemask_epi8(_mm_cmpgt_epi8(constant, values));
+    case 4:
+        return ~_mm_movemask_epi8(_mm_cmpgt_epi8(values, constant)) & 0xffff;
+    }
+    return ~_mm_movemask_epi8(_mm_cmpeq_epi8(values, constant)) & 0xffff;
+}
+void compare_char_sse2(const char* values, int count, char constant, int logic_type, unsigned long long* matches)
+{
+    __m128i constants = _mm_set1_epi8(constant);
+    int i = 0;
+
+    for(; i + 64 <= count; i += 64)
+    {
+        unsigned long long word = 0;
+        for(int lane = 0; lane < 64; lane += 16)
+        {
+            word |= (unsigned long long)get_char_mask_sse2(_mm_loadu_si128((const __m128i*)(values + i + lane)), constants, logic_type) << lane;
+        }
+        *(matches + (i >> 6)) = word;
+    }
+    compare_char_scalar(values, i, count, constant, logic_type, matches);
+}
+
+static inline SIMD_TARGET_AVX2 int get_int_mask_avx2(__m256i values, __m256i constant, int logic_type)
+{
+    switch (logic_type)
+    {
+    case 0:
+        return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(values, constant)));
+    case 1:
+        return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(values, constant)));
+    case 2:
+        return ~_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(constant, values))) & 0xff;
+    case 3:
+        return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(constant, values)));
+    case 4:
+        return ~_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(values, constant))) & 0xff;
+    }
+    return ~_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(values, constant))) & 0xff;
+}
+SIMD_TARGET_AVX2 void compare_int_avx2(const int* values, int count, int constant, int logic_type, unsigned long long* matches)
+{
+    __m256i constants = _mm256_set1_epi32(constant);
+    int i = 0;
+
+    for(; i + 64 <= count; i += 64)
+    {
+        unsigned long long word = 0;
+        for(int lane = 0; lane < 64; lane += 8)
+        {
+            word |= (unsigned long long)get_int_mask_avx2(_mm256_loadu_si256((const __m256i*)(values + i + lane)), constants, logic_type) << lane;
+        }
+        *(matches + (i >> 6)) = word;
+    }
+    compare_int_scalar(values, i, count, constant, logic_type, matches);
+}
+//Ordered predicates are false on NaN, != is the unordered one so NaN matches it
+static inline SIMD_TARGET_AVX2 int get_float_mask_avx2(__m256 values, __m256 constant, int logic_type)
+{
+    switch (logic_type)
+    {
+    case 0:
+        return _mm256_movemask_ps(_mm256_cmp_ps(values, constant, _CMP_EQ_OQ));
+    case 1:
+        return _mm256_movemask_ps(_mm256_cmp_ps(values, constant, _CMP_GT_OQ));
+    case 2:
+        return _mm256_movemask_ps(_mm256_cmp_ps(values, constant, _CMP_GE_OQ));
+    case 3:
+        return _mm256_movemask_ps(_mm256_cmp_ps(values, constant, _CMP_LT_OQ));
+    case 4:
+        return _mm256_movemask_ps(_mm256_cmp_ps(values, constant, _CMP_LE_OQ));
+    }
+    return _mm256_movemask_ps(_mm256_cmp_ps(values, constant, _CMP_NEQ_UQ));
+}
+SIMD_TARGET_AVX2 void compare_float_avx2(const float* values, int count, float constant, int logic_type, unsigned long long* matches)
+{
+    __m256 constants = _mm256_set1_ps(constant);
+    int i = 0;
+
+    for(; i + 64 <= count; i += 64)
+    {
+        unsigned long long word = 0;
+        for(int lane = 0; lane < 64; lane += 8)
+        {
+            word |= (unsigned long long)get_float_mask_avx2(_mm256_loadu_ps(values + i + lane), constants, logic_type) << lane;
+        }
+        *(matches + (i >> 6)) = word;
+    }
+    compare_float_scalar(values, i, count, constant, logic_type, matches);
+}
+static inline SIMD_TARGET_AVX2 unsigned int get_char_mask_avx2(__m256i values, __m256i constant, int logic_type)
+{
+    switch (logic_type)
+    {
+    case 0:
+        return (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(values, constant));
+    case 1:
+        return (unsigned int)_mm256_movemask_epi8(_mm256_cmpgt_epi8(values, constant));
+    case 2:
+        return ~(unsigned int)_mm256_movemask_epi8(_mm256_cmpgt_epi8(constant, values));
+    case 3:
+        return (unsigned int)_mm256_movemask_epi8(_mm256_cmpgt_epi8(constant, values));
+    case 4:
+        return ~(unsigned int)_mm256_movemask_epi8(_mm256_cmpgt_epi8(values, constant));
+    }
+    return ~(unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(values, constant));
+}
+SIMD_TARGET_AVX2 void compare_char_avx2(const char* values, int count, char constant, int logic_type, unsigned long long* matches)
+{
+    __m256i constants = _mm256_set1_epi8(constant);
+    int i = 0;
+
+    for(; i + 64 <= count; i += 64)
+    {
+        unsigned long long low = get_char_mask_avx2(_mm256_loadu_si256((const __m256i*)(values + i)), constants, logic_type);
+        unsigned long long high = get_char_mask_avx2(_mm256_loadu_si256((const __m256i*)(values + i + 32)), constants, logic_type);
+        *(matches + (i >> 6)) = low | (high << 32);
+    }
+    compare_char_scalar(values, i, count, constant, logic_type, matches);
+}
+#endif
+
+//AVX2 needs both the processor flag and the operating system saving the wide registers
+enum SIMD_LEVEL get_supported_simd_level()
+{
+#ifdef SIMD_X86
+    unsigned int info[4] = { 0, 0, 0, 0 };
+#if defined(_MSC_VER)
+    __cpuid((int*)info, 1);
+#else
+    __cpuid(1, info[0], info[1], info[2], info[3]);
+#endif
+    int has_sse2 = (info[3] >> 26) & 1;
+    int has_osxsave = (info[2] >> 27) & 1;
+    int has_avx = (info[2] >> 28) & 1;
+
+    if(has_osxsave && has_avx)
+    {
+#if defined(_MSC_VER)
+        unsigned long long xcr0 = _xgetbv(0);
+        __cpuidex((int*)info, 7, 0);
+#else
+        unsigned int xcr0_low;
+        unsigned int xcr0_high;
+        __asm__("xgetbv" : "=a"(xcr0_low), "=d"(xcr0_high) : "c"(0));
+        unsigned long long xcr0 = ((unsigned long long)xcr0_high << 32) | xcr0_low;
+        __cpuid_count(7, 0, info[0], info[1], info[2], info[3]);
+#endif
+        if((xcr0 & 6) == 6 && ((info[1] >> 5) & 1))
+        {
+            return SIMD_AVX2;
+        }
+    }
+    if(has_sse2)
+    {
+        return SIMD_SSE2;
+    }
+#endif
+    return SIMD_SCALAR;
+}
+enum SIMD_LEVEL get_simd_level()
+{
+    if(!is_simd_level_set)
+    {
+        simd_level = get_supported_simd_level();
+        is_simd_level_set = 1;
+    }
+
+    return simd_level;
+}
+//Levels above what the processor supports are lowered to it
+void set_simd_level(enum SIMD_LEVEL level)
+{
+    enum SIMD_LEVEL supported = get_supported_simd_level();
+
+    simd_level = level < supported ? level : supported;
+    is_simd_level_set = 1;
+}
+
+void compare_int_block(const int* values, int count, int constant, int logic_type, unsigned long long* matches)
+{
+    memset(matches, 0, ((count + 63) / 64) * sizeof(unsigned long long));
+
+#ifdef SIMD_X86
+    enum SIMD_LEVEL level = get_simd_level();
+    if(level == SIMD_AVX2)
+    {
+        compare_int_avx2(values, count, constant, logic_type, matches);
+        return;
+    }
+    if(level == SIMD_SSE2)
+    {
+        compare_int_sse2(values, count, constant, logic_type, matches);
+        return;
+    }
+#endif
+    compare_int_scalar(values, 0, count, constant, logic_type, matches);
+}
+void compare_float_block(const float* values, int count, float constant, int logic_type, unsigned long long* matches)
+{
+    memset(matches, 0, ((count + 63) / 64) * sizeof(unsigned long long));
+
+#ifdef SIMD_X86
+    enum SIMD_LEVEL level = get_simd_level();
+    if(level == SIMD_AVX2)
+    {
+        compare_float_avx2(values, count, constant, logic_type, matches);
+        return;
+    }
+    if(level == SIMD_SSE2)
+    {
+        compare_float_sse2(values, count, constant, logic_type, matches);
+        return;
+    }
+#endif
+    compare_float_scalar(values, 0, count, constant, logic_type, matches);
+}
+void compare_char_block(const char* values, int count, char constant, int logic_type, unsigned long long* matches)
+{
+    memset(matches, 0, ((count + 63) / 64) * sizeof(unsigned long long));
+
+#ifdef SIMD_X86
+    enum SIMD_LEVEL level = get_simd_level();
+    if(level == SIMD_AVX2)
+    {
+        compare_char_avx2(values, count, constant, logic_type, matches);
+        return;
+    }
+    if(level == SIMD_SSE2)
+    {
+        compare_char_sse2(values, count, constant, logic_type, matches);
+        return;
+    }
+#endif
+    compare_char_scalar(values, 0, count, constant, logic_type, matches);
+}
@@ -0,0 +1,23 @@
+#ifndef SIMD
+#define SIMD
+
+//Comparison kernels that test a whole block of values against a constant and set one bit per matching value in
+//matches, which must hold (count + 63) / 64 words. Operators use the WHERE numbering : 0 =, 1 >, 2 >=, 3 <, 4 <=, 5 !=.
+//Floats compare like C does, so a NaN only matches !=.
+//The widest instruction set the processor supports is picked on first use, SIMD_SCALAR forces the plain loops
+enum SIMD_LEVEL
+{
+    SIMD_SCALAR,
+    SIMD_SSE2,
+    SIMD_AVX2
+};
+
+enum SIMD_LEVEL get_simd_level();
+void set_simd_level(enum SIMD_LEVEL level);
+enum SIMD_LEVEL get_supported_simd_level();
+
+void compare_int_block(const int* values, int count, int constant, int logic_type, unsigned long long* matches);
+void compare_float_block(const float* values, int count, float constant, int logic_type, unsigned long long* matches);
+void compare_char_block(const char* values, int count, char constant, int logic_type, unsigned long long* matches);
+
+#endif
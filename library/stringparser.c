@@ -2,6 +2,7 @@
 #include <malloc.h>
 #include <string.h>
 #include "collections.h"
+#include "arena.h"
 #include <stdio.h>
 
 char* copy_string(char* from, int size)
@@ -13,11 +14,35 @@ char* copy_string(char* from, int size)
     return string;
 }
 
-parsedata* parse(char* string, int buffer_size, char* parse_seperator, int seperator_size, char* parse_joinner, int joinner_size)
+//Every allocation comes from memory when it is not NULL, otherwise from the heap
+void* allocate_parse_memory(arena* memory, int size)
+{
+    if(memory != NULL)
+    {
+        return allocate_arena_memory(memory, size);
+    }
+
+    return malloc(size);
+}
+
+void add_parseindex(parseindex* list, int* count, parseindex* current)
+{
+    *(list + *count) = *current;
+    *count += 1;
+}
+
+parsedata* parse_on_arena(arena* memory, char* string, int buffer_size, char* parse_seperator, int seperator_size, char* parse_joinner, int joinner_size)
 {
     int index = 0;
-    
-    linked_list* list = allocate_linked_list(sizeof(parseindex));
+
+    //A line never holds more tokens than characters
+    int list_count = 0;
+    int list_capacity = 1;
+    while (list_capacity <= buffer_size && *(string + list_capacity - 1) != '\0')
+    {
+        list_capacity++;
+    }
+    parseindex* list = allocate_parse_memory(memory, sizeof(parseindex) * list_capacity);
 
     parseindex current;
     current.start = 0;
@@ -66,7 +91,7 @@ parsedata* parse(char* string, int buffer_size, char* parse_seperator, int seper
                 if(current.start != index)
                 {
                     current.end = index;
-                    add_linked_list_value(list, &current);
+                    add_parseindex(list, &list_count, &current);
                 }
 
                 current.start = index + 1;
@@ -83,7 +108,7 @@ parsedata* parse(char* string, int buffer_size, char* parse_seperator, int seper
                     else
                     {
                         current.end = index;
-                        add_linked_list_value(list, &current);
+                        add_parseindex(list, &list_count, &current);
 
                         current.start = index + 1;
                         current.end = index;
@@ -98,7 +123,7 @@ parsedata* parse(char* string, int buffer_size, char* parse_seperator, int seper
                 current.end = index;
                 current_join = 0;
 
-                add_linked_list_value(list, &current);
+                add_parseindex(list, &list_count, &current);
 
                 current.start = index + 1;
                 current.end = index;
@@ -111,24 +136,24 @@ parsedata* parse(char* string, int buffer_size, char* parse_seperator, int seper
     if(current.start < buffer_size && current.start != index)
     {
         current.end = index;
-        add_linked_list_value(list, &current);
+        add_parseindex(list, &list_count, &current);
     }
 
-    parsedata* data = malloc(sizeof(parsedata));
-    data->length = list->count;
-    char** char_array = malloc(sizeof(char*) * data->length);
-    int* count_array = malloc(sizeof(int) * data->length);
+    parsedata* data = allocate_parse_memory(memory, sizeof(parsedata));
+    data->length = list_count;
+    char** char_array = allocate_parse_memory(memory, sizeof(char*) * data->length);
+    int* count_array = allocate_parse_memory(memory, sizeof(int) * data->length);
     data->data = char_array;
     data->size = count_array;
 
-    for(int i = 0; i < list->count; i++)
+    for(int i = 0; i < list_count; i++)
     {
-        current = *((parseindex*)get_linked_list_data(list, i));
+        current = *(list + i);
 
         int len = current.end - current.start + 1;
         *(count_array + i) = len - 1;
 
-        char* buffer = malloc(len);
+        char* buffer = allocate_parse_memory(memory, len);
         *(buffer + len - 1) = '\0';
 
         int buffer_index = 0;
@@ -141,10 +166,17 @@ parsedata* parse(char* string, int buffer_size, char* parse_seperator, int seper
         *(char_array + i) = buffer;
     }
 
-    free_linked_list(list);
+    if(memory == NULL)
+    {
+        free(list);
+    }
 
     return data;
 }
+parsedata* parse(char* string, int buffer_size, char* parse_seperator, int seperator_size, char* parse_joinner, int joinner_size)
+{
+    return parse_on_arena(NULL, string, buffer_size, parse_seperator, seperator_size, parse_joinner, joinner_size);
+}
 
 void free_parsedata(parsedata* data)
 {
@@ -152,6 +184,7 @@ void free_parsedata(parsedata* data)
     {
         free(data->data[i]);
     }
+    free(data->data);
     free(data->size);
     free(data);
 }
@@ -1,6 +1,8 @@
 #ifndef STRINGPARSER
 #define STRINGPARSER
 
+#include "arena.h"
+
 typedef struct parsedata
 {
     char** data;
@@ -14,7 +16,9 @@ typedef struct parseindex
 } parseindex;
 
 char* copy_string(char* from, int size);
+parsedata* parse_on_arena(arena* memory, char* string, int buffer_size, char* parse_seperator, int seperator_size, char* parse_joinner, int joinner_size);
 parsedata* parse(char* string, int buffer_size, char* parse_seperator, int seperator_size, char* parse_joinner, int joinner_size);
+//Only for parsedata returned by parse, parsedata from parse_on_arena is released with its arena
 void free_parsedata(parsedata* data);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,553 @@
+#include "writer.h"
+#include "collections.h"
+#include <string.h>
+#include <stdlib.h>
+
+result_writer* allocate_result_writer(FILE* file)
+{
+    result_writer* writer = (result_writer*)heapallocate(sizeof(result_writer));
+    writer->file = file;
+    writer->buffer = (char*)heapallocate(RESULT_WRITER_SIZE);
+    writer->count = 0;
+    writer->capacity = RESULT_WRITER_SIZE;
+
+    return writer;
+}
+void reserve_result_writer(result_writer* writer, int size)
+{
+    if(writer->count + size > writer->capacity)
+    {
+        flush_result_writer(writer);
+    }
+}
+
+void write_result_char(result_writer* writer, char value)
+{
+    reserve_result_writer(writer, 1);
+    *(writer->buffer + writer->count) = value;
+    writer->count++;
+}
+//Values larger than the buffer skip it
+void write_result_string(result_writer* writer, const char* value, int length)
+{
+    if(length == 0)
+    {
+        return;
+    }
+
+    reserve_result_writer(writer, length);
+    if(length > writer->capacity)
+    {
+        fwrite(value, 1, length, writer->file);
+        return;
+    }
+
+    memcpy(writer->buffer + writer->count, value, length);
+    writer->count += length;
+}
+void write_result_text(result_writer* writer, const char* value)
+{
+    write_result_string(writer, value, (int)strlen(value));
+}
+//Digits are produced from the back into a small scratch buffer
+void write_result_unsigned(result_writer* writer, unsigned long long value, int min_digits)
+{
+    char digits[24];
+    int position = sizeof(digits);
+
+    do
+    {
+        digits[--position] = (char)('0' + value % 10);
+        value /= 10;
+        min_digits--;
+    } while (value != 0 || min_digits > 0);
+
+    write_result_string(writer, digits + position, sizeof(digits) - position);
+}
+void write_result_int(result_writer* writer, int value)
+{
+    write_result_long(writer, value);
+}
+void write_result_long(result_writer* writer, long long value)
+{
+    unsigned long long magnitude = (unsigned long long)value;
+    if(value < 0)
+    {
+        write_result_char(writer, '-');
+        magnitude = 0 - magnitude;
+    }
+
+    write_result_unsigned(writer, magnitude, 1);
+}
+//Same text as %f. A float is mantissa * 2^shift, so below 2^64 its value times 10^6 fits 64 bits and is rounded
+//half to even from the exact value like printf does. NaN, infinities and larger values keep the platform's own text
+void write_result_float(result_writer* writer, float value)
+{
+    unsigned int bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    if(value != value || value >= 18446744073709551616.0f || value <= -18446744073709551616.0f)
+    {
+        write_result_double(writer, value);
+        return;
+    }
+
+    int exponent = (bits >> 23) & 0xff;
+    unsigned long long mantissa = bits & 0x7fffff;
+    if(exponent == 0)
+    {
+        exponent = 1;
+    }
+    else
+    {
+        mantissa |= 1ull << 23;
+    }
+
+    int shift = exponent - 150;
+    unsigned long long whole = 0;
+    unsigned long long fraction = 0;
+
+    if(shift >= 0)
+    {
+        whole = mantissa << shift;
+    }
+    else if(-shift < 45)
+    {
+        int bits_below = -shift;
+        unsigned long long scaled = mantissa * 1000000ull;
+        unsigned long long rounded = scaled >> bits_below;
+        unsigned long long remainder = scaled & ((1ull << bits_below) - 1);
+        unsigned long long half = 1ull << (bits_below - 1);
+
+        rounded += remainder > half || (remainder == half && (rounded & 1));
+        whole = rounded / 1000000;
+        fraction = rounded % 1000000;
+    }
+
+    if(bits >> 31)
+    {
+        write_result_char(writer, '-');
+    }
+    write_result_unsigned(writer, whole, 1);
+    write_result_char(writer, '.');
+    write_result_unsigned(writer, fraction, 6);
+}
+void write_result_double_format(result_writer* writer, const char* format, double value)
+{
+    reserve_result_writer(writer, RESULT_NUMBER_SIZE);
+
+    int length = snprintf(writer->buffer + writer->count, RESULT_NUMBER_SIZE, format, value);
+    if(length >= RESULT_NUMBER_SIZE)
+    {
+        flush_result_writer(writer);
+        fprintf(writer->file, format, value);
+        return;
+    }
+    writer->count += length;
+}
+void write_result_double(result_writer* writer, double value)
+{
+    write_result_double_format(writer, "%f", value);
+}
+//Fewest significant digits from 6 up that read back as the same float
+void write_result_float_round_trip(result_writer* writer, float value)
+{
+    char text[RESULT_NUMBER_SIZE];
+
+    if(value != value)
+    {
+        write_result_text(writer, "nan");
+        return;
+    }
+    if(value - value != 0)
+    {
+        write_result_text(writer, value > 0 ? "inf" : "-inf");
+        return;
+    }
+
+    for(int precision = 6; precision <= 9; precision++)
+    {
+        snprintf(text, sizeof(text), "%.*g", precision, value);
+        if(strtof(text, NULL) == value)
+        {
+            break;
+        }
+    }
+    write_result_text(writer, text);
+}
+void set_result_writer_file(result_writer* writer, FILE* file)
+{
+    flush_result_writer(writer);
+    writer->file = file;
+}
+void flush_result_writer(result_writer* writer)
+{
+    if(writer->count > 0)
+    {
+        fwrite(writer->buffer, 1, writer->count, writer->file);
+        writer->count = 0;
+    }
+}
+void free_result_writer(result_writer* writer)
+{
+    flush_result_writer(writer);
+    free(writer->buffer);
+    free(writer);
+}
+
+result_sink* allocate_result_sink(result_writer* writer)
+{
+    result_sink* sink = (result_sink*)heapallocate(sizeof(result_sink));
+    sink->format = TEXT_FORMAT;
+    sink->writer = writer;
+    sink->columns = allocate_array_list(sizeof(result_column));
+    sink->column = 0;
+    sink->row_count = 0;
+
+    return sink;
+}
+//Columns are added after the format is set, only BINARY keeps their values
+void add_result_column(result_sink* sink, const char* prefix, const char* name, enum RESULT_TYPE type)
+{
+    int prefix_length = prefix != NULL ? (int)strlen(prefix) + 1 : 0;
+    int name_length = (int)strlen(name);
+
+    result_column column;
+    column.name = (char*)heapallocate(prefix_length + name_length + 1);
+    if(prefix != NULL)
+    {
+        memcpy(column.name, prefix, prefix_length - 1);
+        *(column.name + prefix_length - 1) = '.';
+    }
+    memcpy(column.name + prefix_length, name, name_length + 1);
+
+    column.type = type;
+    column.missing_count = 0;
+    column.present = NULL;
+    column.offsets = NULL;
+    column.values = NULL;
+    if(sink->format == BINARY_FORMAT)
+    {
+        column.present = allocate_array_list(sizeof(char));
+        column.offsets = allocate_array_list(sizeof(int));
+        column.values = allocate_array_list(sizeof(char));
+    }
+
+    add_array_list_value(sink->columns, &column);
+}
+result_column* get_result_column(result_sink* sink, int index)
+{
+    return (result_column*)get_array_list_data(sink->columns, index);
+}
+
+void write_csv_string(result_writer* writer, const char* value, int length)
+{
+    int is_quoted = length == 0;
+    for(int i = 0; i < length; i++)
+    {
+        char character = *(value + i);
+        is_quoted |= character == ',' || character == '"' || character == '\n' || character == '\r';
+    }
+    if(!is_quoted)
+    {
+        write_result_string(writer, value, length);
+        return;
+    }
+
+    write_result_char(writer, '"');
+    for(int i = 0; i < length; i++)
+    {
+        if(*(value + i) == '"')
+        {
+            write_result_char(writer, '"');
+        }
+        write_result_char(writer, *(value + i));
+    }
+    write_result_char(writer, '"');
+}
+void write_json_string(result_writer* writer, const char* value, int length)
+{
+    const char* hex = "0123456789abcdef";
+
+    write_result_char(writer, '"');
+    for(int i = 0; i < length; i++)
+    {
+        unsigned char character = (unsigned char)*(value + i);
+        if(character == '"' || character == '\\')
+        {
+            write_result_char(writer, '\\');
+            write_result_char(writer, (char)character);
+        }
+        else if(character < 0x20)
+        {
+            write_result_text(writer, "\\u00");
+            write_result_char(writer, hex[character >> 4]);
+            write_result_char(writer, hex[character & 15]);
+        }
+        else
+        {
+            write_result_char(writer, (char)character);
+        }
+    }
+    write_result_char(writer, '"');
+}
+void add_binary_value(result_column* column, const void* value, int size)
+{
+    if(size == 0)
+    {
+        return;
+    }
+
+    reserve_array_list(column->values, column->values->count + size);
+    memcpy(column->values->data + column->values->count, value, size);
+    column->values->count += size;
+}
+
+//TEXT and CSV start with a row of column names
+void begin_result_rows(result_sink* sink)
+{
+    sink->column = 0;
+    sink->row_count = 0;
+    if(sink->format != TEXT_FORMAT && sink->format != CSV_FORMAT)
+    {
+        return;
+    }
+
+    for(int i = 0; i < sink->columns->count; i++)
+    {
+        char* name = get_result_column(sink, i)->name;
+        if(sink->format == TEXT_FORMAT)
+        {
+            write_result_text(sink->writer, i > 0 ? " | " : "");
+            write_result_text(sink->writer, name);
+        }
+        else
+        {
+            write_result_text(sink->writer, i > 0 ? "," : "");
+            write_csv_string(sink->writer, name, (int)strlen(name));
+        }
+    }
+    write_result_char(sink->writer, '\n');
+}
+//Separator or key in front of the next value of the row, BINARY records whether the value is there instead
+result_column* begin_result_cell(result_sink* sink, int is_present)
+{
+    result_column* column = get_result_column(sink, sink->column);
+
+    if(sink->format == TEXT_FORMAT && sink->column > 0)
+    {
+        write_result_string(sink->writer, " | ", 3);
+    }
+    else if(sink->format == CSV_FORMAT && sink->column > 0)
+    {
+        write_result_char(sink->writer, ',');
+    }
+    else if(sink->format == JSONL_FORMAT)
+    {
+        write_result_char(sink->writer, sink->column == 0 ? '{' : ',');
+        write_json_string(sink->writer, column->name, (int)strlen(column->name));
+        write_result_char(sink->writer, ':');
+    }
+    else if(sink->format == BINARY_FORMAT)
+    {
+        add_array_list_char(column->present, (char)is_present);
+        column->missing_count += !is_present;
+        if(column->type == RESULT_STRING)
+        {
+            add_array_list_int(column->offsets, column->values->count);
+        }
+    }
+
+    sink->column++;
+    return column;
+}
+void write_result_cell_int(result_sink* sink, int value)
+{
+    result_column* column = begin_result_cell(sink, 1);
+    if(sink->format == BINARY_FORMAT)
+    {
+        add_binary_value(column, &value, sizeof(value));
+        return;
+    }
+
+    write_result_int(sink->writer, value);
+}
+void write_result_cell_long(result_sink* sink, long long value)
+{
+    result_column* column = begin_result_cell(sink, 1);
+    if(sink->format == BINARY_FORMAT)
+    {
+        add_binary_value(column, &value, sizeof(value));
+        return;
+    }
+
+    write_result_long(sink->writer, value);
+}
+void write_result_cell_float(result_sink* sink, float value)
+{
+    result_column* column = begin_result_cell(sink, 1);
+    if(sink->format == BINARY_FORMAT)
+    {
+        add_binary_value(column, &value, sizeof(value));
+    }
+    else if(sink->format == TEXT_FORMAT)
+    {
+        write_result_float(sink->writer, value);
+    }
+    else if(sink->format == JSONL_FORMAT && value - value != 0)
+    {
+        write_result_text(sink->writer, "null");
+    }
+    else
+    {
+        write_result_float_round_trip(sink->writer, value);
+    }
+}
+void write_result_cell_double(result_sink* sink, double value)
+{
+    result_column* column = begin_result_cell(sink, 1);
+    if(sink->format == BINARY_FORMAT)
+    {
+        add_binary_value(column, &value, sizeof(value));
+    }
+    else if(sink->format == TEXT_FORMAT)
+    {
+        write_result_double(sink->writer, value);
+    }
+    else if(sink->format == JSONL_FORMAT && value - value != 0)
+    {
+        write_result_text(sink->writer, "null");
+    }
+    else
+    {
+        write_result_double_format(sink->writer, "%.17g", value);
+    }
+}
+void write_result_cell_char(result_sink* sink, char value)
+{
+    result_column* column = begin_result_cell(sink, 1);
+    if(sink->format == BINARY_FORMAT)
+    {
+        add_binary_value(column, &value, sizeof(value));
+    }
+    else if(sink->format == TEXT_FORMAT)
+    {
+        write_result_char(sink->writer, value);
+    }
+    else if(sink->format == CSV_FORMAT)
+    {
+        write_csv_string(sink->writer, &value, 1);
+    }
+    else
+    {
+        write_json_string(sink->writer, &value, 1);
+    }
+}
+void write_result_cell_string(result_sink* sink, const char* value, int length)
+{
+    result_column* column = begin_result_cell(sink, 1);
+    if(sink->format == BINARY_FORMAT)
+    {
+        add_binary_value(column, value, length);
+    }
+    else if(sink->format == TEXT_FORMAT)
+    {
+        write_result_string(sink->writer, value, length);
+    }
+    else if(sink->format == CSV_FORMAT)
+    {
+        write_csv_string(sink->writer, value, length);
+    }
+    else
+    {
+        write_json_string(sink->writer, value, length);
+    }
+}
+void write_result_cell_missing(result_sink* sink)
+{
+    const long long zero = 0;
+    result_column* column = begin_result_cell(sink, 0);
+
+    if(sink->format == BINARY_FORMAT)
+    {
+        int sizes[] = {sizeof(int), sizeof(long long), sizeof(float), sizeof(double), sizeof(char), 0};
+        add_binary_value(column, &zero, sizes[column->type]);
+    }
+    else if(sink->format == TEXT_FORMAT)
+    {
+        write_result_text(sink->writer, "nan");
+    }
+    else if(sink->format == JSONL_FORMAT)
+    {
+        write_result_text(sink->writer, "null");
+    }
+}
+void end_result_row(result_sink* sink)
+{
+    if(sink->format == TEXT_FORMAT || sink->format == CSV_FORMAT)
+    {
+        write_result_char(sink->writer, '\n');
+    }
+    else if(sink->format == JSONL_FORMAT)
+    {
+        write_result_text(sink->writer, "}\n");
+    }
+
+    sink->column = 0;
+    sink->row_count++;
+}
+void write_binary_result(result_sink* sink)
+{
+    int header[] = {1, sink->columns->count, sink->row_count};
+
+    write_result_string(sink->writer, "SQITSCOL", 8);
+    write_result_string(sink->writer, (const char*)header, sizeof(header));
+    for(int i = 0; i < sink->columns->count; i++)
+    {
+        result_column* column = get_result_column(sink, i);
+        int name_length = (int)strlen(column->name);
+
+        write_result_char(sink->writer, (char)column->type);
+        write_result_string(sink->writer, (const char*)&name_length, sizeof(name_length));
+        write_result_string(sink->writer, column->name, name_length);
+    }
+
+    for(int i = 0; i < sink->columns->count; i++)
+    {
+        result_column* column = get_result_column(sink, i);
+
+        write_result_char(sink->writer, column->missing_count > 0);
+        if(column->missing_count > 0)
+        {
+            write_result_string(sink->writer, column->present->data, column->present->count);
+        }
+        if(column->type == RESULT_STRING)
+        {
+            add_array_list_int(column->offsets, column->values->count);
+            write_result_string(sink->writer, column->offsets->data, column->offsets->count * sizeof(int));
+        }
+        write_result_string(sink->writer, column->values->data, column->values->count);
+    }
+}
+//Writes what BINARY held back and forgets the columns
+void finish_result(result_sink* sink)
+{
+    if(sink->format == BINARY_FORMAT)
+    {
+        write_binary_result(sink);
+    }
+
+    for(int i = 0; i < sink->columns->count; i++)
+    {
+        result_column* column = get_result_column(sink, i);
+        free(column->name);
+        if(column->values != NULL)
+        {
+            free_array_list(column->present);
+            free_array_list(column->offsets);
+            free_array_list(column->values);
+        }
+    }
+    clear_array_list(sink->columns);
+    flush_result_writer(sink->writer);
+}
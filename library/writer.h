@@ -0,0 +1,89 @@
+#ifndef WRITER
+#define WRITER
+
+#include <stdio.h>
+#include "collections.h"
+
+//Buffered output for query results. Values are formatted straight into one reusable buffer that is written out
+//in large blocks, numbers come out exactly as printf would print them
+#define RESULT_WRITER_SIZE 65536
+#define RESULT_NUMBER_SIZE 64
+
+typedef struct result_writer
+{
+    FILE* file;
+    char* buffer;
+    int count;
+    int capacity;
+} result_writer;
+
+result_writer* allocate_result_writer(FILE* file);
+void write_result_char(result_writer* writer, char value);
+void write_result_string(result_writer* writer, const char* value, int length);
+void write_result_text(result_writer* writer, const char* value);
+void write_result_int(result_writer* writer, int value);
+void write_result_long(result_writer* writer, long long value);
+void write_result_float(result_writer* writer, float value);
+void write_result_double(result_writer* writer, double value);
+void write_result_float_round_trip(result_writer* writer, float value);
+void set_result_writer_file(result_writer* writer, FILE* file);
+void flush_result_writer(result_writer* writer);
+void free_result_writer(result_writer* writer);
+
+//Formats a result is written in. TEXT is the DISPLAY table, CSV has a header row and quotes strings when needed,
+//JSONL writes one object per row with NaN as null. Missing values, like an aggregate over no values, are nan in TEXT,
+//empty in CSV and null in JSONL.
+//BINARY keeps every column until the result ends and then writes it column at a time, in native byte order :
+//"SQITSCOL", int version, int column count, int row count, then per column a RESULT_TYPE byte, an int name length
+//and the name, then per column a byte telling if it has missing values, if so one byte per row that is 1 for present
+//values, then the values. INT and FLOAT are 4 bytes, LONG and DOUBLE 8, CHAR 1, STRING an int offset per row plus one
+//for the end followed by the bytes of all strings. Missing values hold zeros
+enum RESULT_FORMAT
+{
+    TEXT_FORMAT,
+    CSV_FORMAT,
+    JSONL_FORMAT,
+    BINARY_FORMAT
+};
+enum RESULT_TYPE
+{
+    RESULT_INT,
+    RESULT_LONG,
+    RESULT_FLOAT,
+    RESULT_DOUBLE,
+    RESULT_CHAR,
+    RESULT_STRING
+};
+
+typedef struct result_column
+{
+    char* name;
+    enum RESULT_TYPE type;
+    int missing_count;
+    array_list* present;
+    array_list* offsets;
+    array_list* values;
+} result_column;
+typedef struct result_sink
+{
+    enum RESULT_FORMAT format;
+    result_writer* writer;
+    array_list* columns;
+    int column;
+    int row_count;
+} result_sink;
+
+result_sink* allocate_result_sink(result_writer* writer);
+void add_result_column(result_sink* sink, const char* prefix, const char* name, enum RESULT_TYPE type);
+void begin_result_rows(result_sink* sink);
+void write_result_cell_int(result_sink* sink, int value);
+void write_result_cell_long(result_sink* sink, long long value);
+void write_result_cell_float(result_sink* sink, float value);
+void write_result_cell_double(result_sink* sink, double value);
+void write_result_cell_char(result_sink* sink, char value);
+void write_result_cell_string(result_sink* sink, const char* value, int length);
+void write_result_cell_missing(result_sink* sink);
+void end_result_row(result_sink* sink);
+void finish_result(result_sink* sink);
+
+#endif
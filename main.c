@@ -2,6 +2,11 @@
 #include <stdlib.h>
 #include "collections.h"
 #include "stringparser.h"
+#include "arena.h"
+#include "btree.h"
+#include "bitmap.h"
+#include "simd.h"
+#include "writer.h"
 #include <string.h>
 #include <ctype.h>
 
@@ -24,6 +29,29 @@ const char* SET_COMMAND = "SET";
 const char* PEEK_COMMAND = "PEEK";
 const char* SCRIPT_COMMAND = "SCRIPT";
 const char* CLEAR_COMMAND = "CLEAR";
+const char* VACUUM_COMMAND = "VACUUM";
+const char* INDEX_COMMAND = "INDEX";
+const char* BITMAP_COMMAND = "BITMAP";
+const char* JOIN_COMMAND = "JOIN";
+const char* ON_COMMAND = "ON";
+const char* GROUP_COMMAND = "GROUP";
+const char* BY_COMMAND = "BY";
+const char* COUNT_COMMAND = "COUNT";
+const char* SUM_COMMAND = "SUM";
+const char* AVG_COMMAND = "AVG";
+const char* MIN_COMMAND = "MIN";
+const char* MAX_COMMAND = "MAX";
+const char* ORDER_COMMAND = "ORDER";
+const char* ASC_COMMAND = "ASC";
+const char* DESC_COMMAND = "DESC";
+const char* LIMIT_COMMAND = "LIMIT";
+const char* OFFSET_COMMAND = "OFFSET";
+const char* FORMAT_COMMAND = "FORMAT";
+const char* INTO_COMMAND = "INTO";
+const char* TEXT_COMMAND = "TEXT";
+const char* CSV_COMMAND = "CSV";
+const char* JSONL_COMMAND = "JSONL";
+const char* BINARY_COMMAND = "BINARY";
 
 #define BUFFER_SIZE 1000
 enum INPUT_TYPE
@@ -42,7 +70,12 @@ enum INPUT_TYPE
     UNKNOWN,
     WHERE,
     SCRIPT,
-    CLEAR
+    CLEAR,
+    VACUUM,
+    GROUP,
+    ORDER,
+    LIMIT,
+    FORMAT
 };
 
 //Create
@@ -62,6 +95,82 @@ const char* VARCHAR_COMMAND = "VARCHAR";
 const char* PRIMARY_COMMAND = "PRIMARY";
 const char* FOREIGN_COMMAND = "FOREIGN";
 const char* PRIMARY_FOREIGN_COMMAND = "PRIMARY/FOREIGN";
+const char* DICTIONARY_COMMAND = "DICTIONARY";
+
+//Rows of a table are split into row groups, each column keeps one chunk per row group
+#define ROW_GROUP_SIZE 4096
+#define ROW_GROUP_SHIFT 12
+
+//VARCHAR rows only hold where their text starts in the chunk string heap and how long it is
+typedef struct STRING_ENTRY
+{
+    int offset;
+    int length;
+} STRING_ENTRY;
+
+//INT chunks of a full row group are compressed with whichever encoding is smallest.
+//Packed chunks store value - base in bit_width bits, run length chunks store runs of equal values
+enum CHUNK_ENCODING
+{
+    PLAIN_ENCODING,
+    PACKED_ENCODING,
+    RUN_LENGTH_ENCODING
+};
+
+typedef struct RUN_ENTRY
+{
+    int value;
+    int end;
+} RUN_ENTRY;
+
+typedef struct COLUMN_CHUNK
+{
+    array_list* rows;
+    array_list* heap;
+    int heap_garbage;
+    enum CHUNK_ENCODING encoding;
+    int encoded_count;
+    int base;
+    int bit_width;
+    unsigned long long* packed;
+    array_list* runs;
+    //Zone maps keep the smallest and largest value a chunk ever received as ordered keys, so a WHERE can skip
+    //chunks whose range cannot match. Deleted values stay in the range until the chunk is vacuumed
+    int zone_count;
+    int has_unordered;
+    char* zone_min;
+    char* zone_max;
+} COLUMN_CHUNK;
+
+//Dictionary columns store a code per row, every distinct value is kept once in the dictionary.
+//CHAR codes take one byte, VARCHAR codes two bytes, a VARCHAR column with more distinct values falls back to the string heap
+#define MAX_DICTIONARY_CODES 65536
+//Rows a condition has to be tested on before its observed hit rate replaces the estimate, counts are halved past the limit
+#define LOGIC_SAMPLE_SIZE 256
+#define LOGIC_SAMPLE_LIMIT (1 << 20)
+
+typedef struct COLUMN_DICTIONARY
+{
+    array_list* values;
+    array_list* heap;
+    hash_map* lookup;
+} COLUMN_DICTIONARY;
+
+//One bitmap of row addresses per distinct value of the column, values are stored as ordered keys
+typedef struct BITMAP_INDEX
+{
+    array_list* keys;
+    array_list* bitmaps;
+    hash_map* lookup;
+} BITMAP_INDEX;
+
+//Deleted rows only get their bit set, their slots are reclaimed when the table is vacuumed
+typedef struct ROW_GROUP
+{
+    int row_count;
+    int live_count;
+    unsigned long long deleted[ROW_GROUP_SIZE / 64];
+} ROW_GROUP;
 
 typedef struct TABLE_ITEM
 {
@@ -72,22 +181,64 @@ typedef struct TABLE_ITEM
     char* name;
     enum VARIABLE_TYPE type;
     int data_size;
-    linked_list* rows;
+    int row_size;
+    array_list* chunks;
+    COLUMN_DICTIONARY* dictionary;
+    struct TABLE_DECLARATION* foreign_table;
+    struct TABLE_ITEM* foreign_column;
+    hash_map* value_counts;
+    hash_map* reference_counts;
+    btree* ordered_index;
+    BITMAP_INDEX* bitmap_index;
 } TABLE_ITEM;
 
 typedef struct TABLE_DECLARATION
 {
     char* name;
-    linked_list* columns;
+    array_list* columns;
+    hash_map* column_lookup;
     int row_count;
+    int deleted_count;
+    array_list* row_groups;
+    hash_map* primary_index;
+    array_list* key_buffer;
 } TABLE_DECLARATION;
 
+//Tables in creation order, with their names hashed to their index
+typedef struct TABLE_CATALOG
+{
+    array_list* declarations;
+    hash_map* lookup;
+} TABLE_CATALOG;
+
+//Outcome of comparing a row value against the constant, indexes the accept table of a LOGIC_ITEM
+enum LOGIC_ORDER
+{
+    LESS_ORDER,
+    EQUAL_ORDER,
+    GREATER_ORDER,
+    UNORDERED
+};
+
+//Bound to its column when created, with the constant already converted to the column type
 typedef struct LOGIC_ITEM
 {
     char* column_name;
     int logic_type;
     char* data;
     int data_size;
+    TABLE_ITEM* column;
+    int int_data;
+    float float_data;
+    char char_data;
+    char accept[4];
+    array_list* dictionary_matches;
+    COLUMN_CHUNK* run_chunk;
+    int run_index;
+    int run_result;
+    float selectivity;
+    int tested_count;
+    int passed_count;
 } LOGIC_ITEM;
 
 typedef struct UPDATE_ITEM
@@ -97,39 +248,221 @@ typedef struct UPDATE_ITEM
     int data_size;
 } UPDATE_ITEM;
 
+//Rows matching a WHERE, either taken from an index or selected a row group at a time. Row groups the zone maps
+//cannot rule out get a selection of their live offsets that every condition narrows down in one pass over the chunk,
+//as a bitmask while the conditions can use the block compare kernels. The buffers are reused by every scan
+typedef struct ROW_SCAN
+{
+    TABLE_DECLARATION* table;
+    linked_list* logics;
+    int is_indexed;
+    array_list* rows;
+    int position;
+    int group;
+    int* selection;
+    int selection_count;
+    unsigned long long* selection_words;
+    unsigned long long* match_words;
+    int* values;
+    bitmap* matches;
+    bitmap* condition;
+} ROW_SCAN;
+
+//Column of either side of a join, side 0 is the left table
+typedef struct JOIN_COLUMN
+{
+    int side;
+    TABLE_ITEM* column;
+} JOIN_COLUMN;
+typedef struct JOIN_ROW
+{
+    int left;
+    int right;
+} JOIN_ROW;
+//Equi join of two tables. Each side is filtered by its own conditions first, then the smaller side is hashed on
+//its join column and the other side probes it. Build rows with the same key are chained through next
+typedef struct HASH_JOIN
+{
+    TABLE_DECLARATION* left_table;
+    TABLE_DECLARATION* right_table;
+    TABLE_ITEM* left_column;
+    TABLE_ITEM* right_column;
+    linked_list* left_logics;
+    linked_list* right_logics;
+    array_list* columns;
+    array_list* left_rows;
+    array_list* right_rows;
+    hash_map* buckets;
+    array_list* next;
+    array_list* key;
+    array_list* matches;
+} HASH_JOIN;
+
+enum AGGREGATE_TYPE
+{
+    GROUP_AGGREGATE,
+    COUNT_AGGREGATE,
+    SUM_AGGREGATE,
+    AVG_AGGREGATE,
+    MIN_AGGREGATE,
+    MAX_AGGREGATE
+};
+//One output column of an aggregating DISPLAY, either a GROUP BY column or a function of a column. COUNT(*) has no column
+typedef struct AGGREGATE_ITEM
+{
+    enum AGGREGATE_TYPE type;
+    TABLE_ITEM* column;
+    char* label;
+} AGGREGATE_ITEM;
+//Running state of one item in one group, MIN and MAX keep the row holding the value
+typedef struct AGGREGATE_VALUE
+{
+    long long count;
+    long long int_sum;
+    double sum;
+    int min_row;
+    int max_row;
+} AGGREGATE_VALUE;
+//Hash aggregation in a single pass over the matching rows. Groups are found by their serialized GROUP BY values,
+//each group keeps its first row for the group columns and one value per item, in the order the groups first appear
+typedef struct HASH_AGGREGATE
+{
+    int is_active;
+    array_list* items;
+    array_list* group_columns;
+    hash_map* groups;
+    array_list* group_rows;
+    array_list* values;
+    array_list* key;
+} HASH_AGGREGATE;
+
+//ORDER BY and LIMIT of a DISPLAY, column is NULL without ORDER BY and limit is -1 without LIMIT.
+//Ordered rows are gathered in a heap with the worst row on top, bounded to offset + limit rows when there is a LIMIT
+typedef struct ROW_ORDER
+{
+    TABLE_ITEM* column;
+    int is_descending;
+    int limit;
+    int offset;
+    array_list* rows;
+} ROW_ORDER;
+
+//The item itself lives in the statement arena, only its caches are on the heap
 void free_logic(LOGIC_ITEM* item)
 {
-    free(item->column_name);
-    free(item->data);
-    free(item);
+    free_array_list(item->dictionary_matches);
 }
 
+void free_column_chunk(COLUMN_CHUNK* chunk)
+{
+    if(chunk->rows != NULL)
+    {
+        free_array_list(chunk->rows);
+    }
+    if(chunk->heap != NULL)
+    {
+        free_array_list(chunk->heap);
+    }
+    if(chunk->runs != NULL)
+    {
+        free_array_list(chunk->runs);
+    }
+    free(chunk->packed);
+    free(chunk->zone_min);
+    free(chunk->zone_max);
+    free(chunk);
+}
+void free_bitmap_index(BITMAP_INDEX* index)
+{
+    for(int i = 0; i < index->bitmaps->count; i++)
+    {
+        free_bitmap(*((bitmap**)get_array_list_data(index->bitmaps, i)));
+    }
+    free_array_list(index->keys);
+    free_array_list(index->bitmaps);
+    free_hash_map(index->lookup);
+    free(index);
+}
+void free_column_dictionary(COLUMN_DICTIONARY* dictionary)
+{
+    free_array_list(dictionary->values);
+    free_array_list(dictionary->heap);
+    free_hash_map(dictionary->lookup);
+    free(dictionary);
+}
 void free_table_declaration(TABLE_DECLARATION* table)
 {
     for(int i = 0; i < table->columns->count; i++)
     {
-        TABLE_ITEM* item = *((TABLE_ITEM**)get_linked_list_data(table->columns, i));
+        TABLE_ITEM* item = *((TABLE_ITEM**)get_array_list_data(table->columns, i));
         free(item->foreign_target_table);
         free(item->foreign_target_column);
         free(item->name);
 
-        free_linked_list(item->rows);
+        for(int j = 0; j < item->chunks->count; j++)
+        {
+            free_column_chunk(*((COLUMN_CHUNK**)get_array_list_data(item->chunks, j)));
+        }
+        free_array_list(item->chunks);
+        if(item->dictionary != NULL)
+        {
+            free_column_dictionary(item->dictionary);
+        }
+        if(item->value_counts != NULL)
+        {
+            free_hash_map(item->value_counts);
+        }
+        if(item->reference_counts != NULL)
+        {
+            free_hash_map(item->reference_counts);
+        }
+        if(item->ordered_index != NULL)
+        {
+            free_btree(item->ordered_index);
+        }
+        if(item->bitmap_index != NULL)
+        {
+            free_bitmap_index(item->bitmap_index);
+        }
         free(item);
     }
 
-    free_linked_list(table->columns);
+    free_array_list(table->columns);
+    free_hash_map(table->column_lookup);
+    free_array_list(table->row_groups);
+    if(table->primary_index != NULL)
+    {
+        free_hash_map(table->primary_index);
+    }
+    free_array_list(table->key_buffer);
     free(table->name);
     free(table);
 }
-void clear_all_table(linked_list* list)
+TABLE_CATALOG* allocate_table_catalog()
+{
+    TABLE_CATALOG* catalog = heapallocate(sizeof(TABLE_CATALOG));
+    catalog->declarations = allocate_array_list(sizeof(TABLE_DECLARATION*));
+    catalog->lookup = allocate_hash_map(sizeof(int));
+
+    return catalog;
+}
+void add_catalog_table(TABLE_CATALOG* catalog, TABLE_DECLARATION* table)
+{
+    int table_index = catalog->declarations->count;
+
+    add_array_list_value(catalog->declarations, &table);
+    put_hash_map_value(catalog->lookup, table->name, strlen(table->name), &table_index);
+}
+void clear_all_table(TABLE_CATALOG* catalog)
 {
-    for(int i = 0; i < list->count; i++)
+    for(int i = 0; i < catalog->declarations->count; i++)
     {
-        TABLE_DECLARATION* table = *((TABLE_DECLARATION**)get_linked_list_data(list, i));
+        TABLE_DECLARATION* table = *((TABLE_DECLARATION**)get_array_list_data(catalog->declarations, i));
         free_table_declaration(table);
     }
 
-    clear_linked_list(list);
+    clear_array_list(catalog->declarations);
+    clear_hash_map(catalog->lookup);
 }
 
 TABLE_ITEM* create_table_item(enum VARIABLE_TYPE type, char* name, int data_size)
@@ -140,7 +473,15 @@ TABLE_ITEM* create_table_item(enum VARIABLE_TYPE type, char* name, int data_size
     column->is_primary = 0;
     column->is_foreign = 0;
     column->foreign_target_table = NULL;
-    column->foreign_target_table = NULL;
+    column->foreign_target_column = NULL;
+    column->chunks = allocate_array_list(sizeof(COLUMN_CHUNK*));
+    column->dictionary = NULL;
+    column->foreign_table = NULL;
+    column->foreign_column = NULL;
+    column->value_counts = NULL;
+    column->reference_counts = NULL;
+    column->ordered_index = NULL;
+    column->bitmap_index = NULL;
 
     if(type == VARCHAR_TYPE)
     {
@@ -148,23 +489,23 @@ TABLE_ITEM* create_table_item(enum VARIABLE_TYPE type, char* name, int data_size
         {
             error_exit("Fatal error when creating table item, data size for varchar is too small : 0\n");
         }
-        column->rows = allocate_linked_list(data_size + 1);
         column->data_size = data_size;
+        column->row_size = sizeof(STRING_ENTRY);
     }
     else if(type == INT_TYPE)
     {
-        column->rows = allocate_linked_list(sizeof(int));
-        column->data_size = column->rows->data_size;
+        column->data_size = sizeof(int);
+        column->row_size = column->data_size;
     }
     else if(type == CHAR_TYPE)
     {
-        column->rows = allocate_linked_list(sizeof(char));
-        column->data_size = column->rows->data_size;
+        column->data_size = sizeof(char);
+        column->row_size = column->data_size;
     }
     else if(type == FLOAT_TYPE)
     {
-        column->rows = allocate_linked_list(sizeof(float));
-        column->data_size = column->rows->data_size;
+        column->data_size = sizeof(float);
+        column->row_size = column->data_size;
     }
     else
     {
@@ -173,478 +514,3183 @@ TABLE_ITEM* create_table_item(enum VARIABLE_TYPE type, char* name, int data_size
 
     return column;
 }
+//Size of the column values once written as ordered keys, strings keep room for their terminator
+int get_column_key_size(TABLE_ITEM* column)
+{
+    if(column->type == VARCHAR_TYPE)
+    {
+        return column->data_size + 1;
+    }
+
+    return column->data_size;
+}
 
-int get_column_index(TABLE_DECLARATION* table, const char* name)
+COLUMN_CHUNK* create_column_chunk(TABLE_ITEM* column)
 {
-    for(int i = 0; i < table->columns->count; i++)
+    COLUMN_CHUNK* chunk = heapallocate(sizeof(COLUMN_CHUNK));
+    chunk->rows = allocate_array_list(column->row_size);
+    chunk->heap = NULL;
+    chunk->heap_garbage = 0;
+    chunk->encoding = PLAIN_ENCODING;
+    chunk->encoded_count = 0;
+    chunk->base = 0;
+    chunk->bit_width = 0;
+    chunk->packed = NULL;
+    chunk->runs = NULL;
+    chunk->zone_count = 0;
+    chunk->has_unordered = 0;
+    chunk->zone_min = heapallocate(get_column_key_size(column));
+    chunk->zone_max = heapallocate(get_column_key_size(column));
+
+    if(column->type == VARCHAR_TYPE && column->dictionary == NULL)
     {
-        TABLE_ITEM* column = *((TABLE_ITEM**)get_linked_list_data(table->columns, i));
+        chunk->heap = allocate_array_list(sizeof(char));
+    }
 
-        if(strcmp(column->name, name) == 0)
-        {
-            return i;
-        }
+    return chunk;
+}
+
+//Copies the string into the chunk heap, truncated to the VARCHAR size, and returns its entry
+STRING_ENTRY push_chunk_string(TABLE_ITEM* column, COLUMN_CHUNK* chunk, char* value)
+{
+    STRING_ENTRY entry;
+    entry.length = strlen(value);
+    if(entry.length > column->data_size)
+    {
+        entry.length = column->data_size;
     }
+    entry.offset = chunk->heap->count;
 
-    return -1;
+    reserve_array_list(chunk->heap, chunk->heap->count + entry.length + 1);
+    memcpy(chunk->heap->data + entry.offset, value, entry.length);
+    *(chunk->heap->data + entry.offset + entry.length) = '\0';
+    chunk->heap->count += entry.length + 1;
+
+    return entry;
 }
-int get_table_index(linked_list* list, const char* name)
+
+//Rewrites the heap with only the strings still referenced by the rows once enough of it is dead
+void compact_chunk_heap(COLUMN_CHUNK* chunk)
 {
-    for(int i = 0; i < list->count; i++)
+    if(chunk->heap_garbage < 1024 || chunk->heap_garbage * 2 < chunk->heap->count)
     {
-        TABLE_DECLARATION* table = *((TABLE_DECLARATION**)get_linked_list_data(list, i));
+        return;
+    }
 
-        if(strcmp(name, table->name) == 0)
-        {
-            return i;
-        }
+    array_list* heap = allocate_array_list(sizeof(char));
+    reserve_array_list(heap, chunk->heap->count - chunk->heap_garbage);
+
+    for(int i = 0; i < chunk->rows->count; i++)
+    {
+        STRING_ENTRY* entry = (STRING_ENTRY*)get_array_list_data(chunk->rows, i);
+        int offset = heap->count;
+
+        memcpy(heap->data + offset, chunk->heap->data + entry->offset, entry->length + 1);
+        heap->count += entry->length + 1;
+        entry->offset = offset;
     }
-    
-    return -1;
+
+    free_array_list(chunk->heap);
+    chunk->heap = heap;
+    chunk->heap_garbage = 0;
 }
 
-TABLE_DECLARATION* create_table_declaration(char* name)
+//Switches a CHAR or VARCHAR column without rows to dictionary encoding
+void make_dictionary_column(TABLE_ITEM* column)
 {
-    TABLE_DECLARATION* table = heapallocate(sizeof(TABLE_DECLARATION));
-    table->name = name;
-    table->columns = allocate_linked_list(sizeof(TABLE_ITEM*));
-    table->row_count = 0;
+    if(column->type != CHAR_TYPE && column->type != VARCHAR_TYPE)
+    {
+        printf("Fatal error when creating dictionary column : %s\n", column->name);
+        error_exit("Fatal error when creating dictionary column, only CHAR and VARCHAR can be dictionary encoded\n");
+    }
 
-    return table;
+    COLUMN_DICTIONARY* dictionary = heapallocate(sizeof(COLUMN_DICTIONARY));
+    dictionary->values = allocate_array_list(sizeof(STRING_ENTRY));
+    dictionary->heap = allocate_array_list(sizeof(char));
+    dictionary->lookup = allocate_hash_map(sizeof(int));
+
+    column->dictionary = dictionary;
+    if(column->type == CHAR_TYPE)
+    {
+        column->row_size = sizeof(unsigned char);
+    }
+    else
+    {
+        column->row_size = sizeof(unsigned short);
+    }
 }
 
-void add_table_item(linked_list* tables, TABLE_DECLARATION* declaration, TABLE_ITEM* item, int is_primary, int is_foreign, char* foreign_target_table, char* foreign_target_column)
+//Turns a VARCHAR dictionary column back into string heap chunks, used once the dictionary runs out of codes
+void convert_dictionary_column(TABLE_ITEM* column)
 {
-    for(int i = 0; i < declaration->columns->count; i++)
+    COLUMN_DICTIONARY* dictionary = column->dictionary;
+
+    column->dictionary = NULL;
+    column->row_size = sizeof(STRING_ENTRY);
+
+    for(int i = 0; i < column->chunks->count; i++)
     {
-        TABLE_ITEM* current = *((TABLE_ITEM**)get_linked_list_data(declaration->columns, i));
-        if(strcmp(current->name, item->name) == 0)
+        COLUMN_CHUNK* chunk = *((COLUMN_CHUNK**)get_array_list_data(column->chunks, i));
+        array_list* codes = chunk->rows;
+
+        chunk->rows = allocate_array_list(column->row_size);
+        chunk->heap = allocate_array_list(sizeof(char));
+        reserve_array_list(chunk->rows, codes->count);
+
+        for(int j = 0; j < codes->count; j++)
         {
-            printf("Fatal error when adding column : %s, in table %s\n", item->name, declaration->name);
-            error_exit("Fatal error when adding column, a column with the same name already exist\n");
+            int code = *((unsigned short*)get_array_list_data(codes, j));
+            STRING_ENTRY* value = (STRING_ENTRY*)get_array_list_data(dictionary->values, code);
+            STRING_ENTRY entry = push_chunk_string(column, chunk, dictionary->heap->data + value->offset);
+
+            add_array_list_value(chunk->rows, &entry);
         }
+
+        free_array_list(codes);
     }
 
-    void* buffer = heapallocate(item->data_size);
-    for(int i = 0; i < declaration->row_count; i++)
+    free_column_dictionary(dictionary);
+}
+
+//Returns the code of the value, adding it to the dictionary when new. Returns -1 when the column had to leave dictionary encoding
+int get_dictionary_code(TABLE_ITEM* column, char* value, int length)
+{
+    int* code = (int*)get_hash_map_data(column->dictionary->lookup, value, length);
+    if(code != NULL)
     {
-        add_linked_list_value(item->rows, buffer);
+        return *code;
     }
 
-    item->is_primary = is_primary;
-    item->is_foreign = is_foreign;
-    item->foreign_target_table = foreign_target_table;
-    item->foreign_target_column = foreign_target_column;
-    
-    if(is_primary)
+    COLUMN_DICTIONARY* dictionary = column->dictionary;
+    int new_code = dictionary->values->count;
+    if((column->type == CHAR_TYPE && new_code > 255) || new_code >= MAX_DICTIONARY_CODES)
     {
-        if(declaration->row_count > 0)
-        {
-            printf("Fatal error when adding column : %s, in table %s\n", item->name, declaration->name);
-            error_exit("Fatal error when adding column, column cannot be made primary since row count is already higher than 0\n");
-        }
+        convert_dictionary_column(column);
+        return -1;
     }
-    if(is_foreign)
-    {
-        int table_index = get_table_index(tables, foreign_target_table);
-        if(table_index == -1)
-        {
-            printf("Fatal error when adding column : %s, in table %s, foreign %s\n", item->name, declaration->name, foreign_target_table);
-            error_exit("Fatal error when adding column, column cannot be made foreign because there is no table with such foreign name\n");
-        }
-        int column_index = get_column_index(*((TABLE_DECLARATION**)get_linked_list_data(tables, table_index)), foreign_target_column);
-        if(column_index == -1)
-        {
-            printf("Fatal error when adding column : %s, in table %s, foreign %s column foreign %s\n", item->name, declaration->name, foreign_target_table, foreign_target_column);
-            error_exit("Fatal error when adding column, column cannot be made foreign because there is no column with such foreign name in foreign table\n");
-        }
 
-        TABLE_DECLARATION* foreign_table = *((TABLE_DECLARATION**)get_linked_list_data(tables, table_index));
-        TABLE_ITEM* foreign_column = *((TABLE_ITEM**)get_linked_list_data(foreign_table->columns, column_index));
+    STRING_ENTRY entry;
+    entry.offset = dictionary->heap->count;
+    entry.length = length;
 
-        if(foreign_column->type != item->type || foreign_column->data_size != item->data_size)
-        {
-            printf("Fatal error when adding column : %s, in table %s, foreign %s column foreign %s\n", item->name, declaration->name, foreign_target_table, foreign_target_column);
-            error_exit("Fatal error when adding column, incorect data type to foreign other table\n");
-        }
-        if(foreign_column->is_primary == 0)
-        {
-            printf("Fatal error when adding column : %s, in table %s, foreign %s column foreign %s\n", item->name, declaration->name, foreign_target_table, foreign_target_column);
-            error_exit("Fatal error when adding column, foreign target is not a primary atribute\n");
-        }
+    reserve_array_list(dictionary->heap, dictionary->heap->count + length + 1);
+    memcpy(dictionary->heap->data + entry.offset, value, length);
+    *(dictionary->heap->data + entry.offset + length) = '\0';
+    dictionary->heap->count += length + 1;
 
-        if(declaration->row_count > 0)
-        {
-            printf("Fatal error when adding column : %s, in table %s\n", item->name, declaration->name);
-            error_exit("Fatal error when adding column, column cannot be made foreign since row count is already higher than 0\n");
-        }
+    add_array_list_value(dictionary->values, &entry);
+    put_hash_map_value(dictionary->lookup, value, length, &new_code);
+
+    return new_code;
+}
+//Same as get_dictionary_code, the string is truncated to the VARCHAR size first
+int get_dictionary_string_code(TABLE_ITEM* column, char* value)
+{
+    int length = strlen(value);
+    if(length > column->data_size)
+    {
+        length = column->data_size;
     }
 
-    add_linked_list_value(declaration->columns, &item);
+    return get_dictionary_code(column, value, length);
 }
 
-void delete_table_row(TABLE_DECLARATION* table, int row)
+int get_packed_value(COLUMN_CHUNK* chunk, int offset)
 {
-    if(row >= table->row_count || row < 0)
+    if(chunk->bit_width == 0)
     {
-        printf("Fatal error when deleting row : %i, in table %s\n", row, table->name);
-        error_exit("Fatal error when deleting row, index is outside bounds of the rows\n");
+        return 0;
     }
 
-    for(int i = 0; i < table->columns->count; i++)
+    long long bit = (long long)offset * chunk->bit_width;
+    int word = (int)(bit >> 6);
+    int shift = (int)(bit & 63);
+    unsigned long long value = *(chunk->packed + word) >> shift;
+
+    if(shift + chunk->bit_width > 64)
     {
-        TABLE_ITEM* table_item = *((TABLE_ITEM**)get_linked_list_data(table->columns, i));
-        remove_linked_list_value_at(table_item->rows, row);
+        value |= *(chunk->packed + word + 1) << (64 - shift);
     }
 
-    table->row_count -= 1;
+    return (int)(value & ((1ull << chunk->bit_width) - 1));
 }
 
-LOGIC_ITEM* create_logic_item(TABLE_DECLARATION* table, char* column, char* logic, int logic_size, char* data, int data_size)
+//Binary search for the run holding the offset
+int find_chunk_run(COLUMN_CHUNK* chunk, int offset)
 {
-    int found_column = 0;
-    for(int i = 0; i < table->columns->count; i++)
+    int low = 0;
+    int high = chunk->runs->count - 1;
+
+    while (low < high)
     {
-        TABLE_ITEM* table_item = *((TABLE_ITEM**)get_linked_list_data(table->columns, i));
-        if(strcmp(table_item->name, column) == 0)
+        int middle = (low + high) / 2;
+        if(((RUN_ENTRY*)get_array_list_data(chunk->runs, middle))->end <= offset)
         {
-            found_column = 1;
-            break;
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
         }
     }
-    if(!found_column)
+
+    return low;
+}
+
+int get_chunk_int(COLUMN_CHUNK* chunk, int offset)
+{
+    if(chunk->encoding == PACKED_ENCODING)
     {
-        printf("Fatal error when creating logic item, cannot find column %s on table %s\n", column, table->name);
-        error_exit("Fatal error when creating logic item, cannot find associated column in table\n");
+        return chunk->base + get_packed_value(chunk, offset);
     }
-    if(logic_size > 2)
+    else if(chunk->encoding == RUN_LENGTH_ENCODING)
     {
-        printf("Fatal error when creating logic item, syntax error for logic comparator %s\n", logic);
-        error_exit("Fatal error when creating logic item, sytax error on comparator\n");
+        return ((RUN_ENTRY*)get_array_list_data(chunk->runs, find_chunk_run(chunk, offset)))->value;
     }
 
-    int logic_type = 0;
-    char first_character = *(logic);
-    if(first_character == '=' && logic_size == 1)
+    return get_array_list_data_int(chunk->rows, offset);
+}
+
+//Picks the smallest of plain, frame of reference bit packing and run length encoding for a full INT chunk
+void compress_int_chunk(COLUMN_CHUNK* chunk)
+{
+    if(chunk->encoding != PLAIN_ENCODING || chunk->rows->count == 0)
     {
-        logic_type = 0;
+        return;
     }
-    else if(first_character == '>')
+
+    int count = chunk->rows->count;
+    int* values = (int*)chunk->rows->data;
+    int minimum_value = *values;
+    int maximum_value = *values;
+    int run_count = 1;
+
+    for(int i = 1; i < count; i++)
     {
-        logic_type = 1;
-        if(logic_size == 2)
+        int value = *(values + i);
+        if(value < minimum_value)
         {
-            if(*(logic + 1) == '=')
-            {
-                logic_type = 2;
-            }
-            else
-            {
-                printf("Fatal error when creating logic item, syntax error for logic comparator %s\n", logic);
-                error_exit("Fatal error when creating logic item, sytax error on comparator\n");
-            }
+            minimum_value = value;
+        }
+        if(value > maximum_value)
+        {
+            maximum_value = value;
+        }
+        if(value != *(values + i - 1))
+        {
+            run_count++;
         }
     }
-    else if(first_character == '<')
+
+    unsigned int range = (unsigned int)((long long)maximum_value - minimum_value);
+    int bit_width = 0;
+    while (bit_width < 32 && (range >> bit_width) != 0)
     {
-        logic_type = 3;
-        if(logic_size == 2)
+        bit_width++;
+    }
+
+    long long plain_size = (long long)count * sizeof(int);
+    long long packed_size = (((long long)count * bit_width + 63) / 64 + 1) * sizeof(unsigned long long);
+    long long run_size = (long long)run_count * sizeof(RUN_ENTRY);
+
+    if(run_size <= packed_size && run_size < plain_size)
+    {
+        chunk->runs = allocate_array_list(sizeof(RUN_ENTRY));
+        reserve_array_list(chunk->runs, run_count);
+
+        RUN_ENTRY run;
+        run.value = *values;
+        for(int i = 1; i < count; i++)
         {
-            if(*(logic + 1) == '=')
-            {
-                logic_type = 4;
-            }
-            else
+            if(*(values + i) != run.value)
             {
-                printf("Fatal error when creating logic item, syntax error for logic comparator %s\n", logic);
-                error_exit("Fatal error when creating logic item, sytax error on comparator\n");
+                run.end = i;
+                add_array_list_value(chunk->runs, &run);
+                run.value = *(values + i);
             }
         }
+        run.end = count;
+        add_array_list_value(chunk->runs, &run);
+
+        chunk->encoding = RUN_LENGTH_ENCODING;
     }
-    else if(first_character == '!')
+    else if(packed_size < plain_size)
     {
-        if(logic_size == 2 && *(logic + 1) == '=')
-        {
-            logic_type = 5;
-        }
-        else
+        chunk->packed = heapallocate((int)packed_size);
+        memset(chunk->packed, 0, (size_t)packed_size);
+
+        for(int i = 0; i < count && bit_width > 0; i++)
         {
-            printf("Fatal error when creating logic item, syntax error for logic comparator %s\n", logic);
-            error_exit("Fatal error when creating logic item, sytax error on comparator\n");
+            unsigned long long value = (unsigned int)((long long)*(values + i) - minimum_value);
+            long long bit = (long long)i * bit_width;
+            int word = (int)(bit >> 6);
+            int shift = (int)(bit & 63);
+
+            *(chunk->packed + word) |= value << shift;
+            if(shift + bit_width > 64)
+            {
+                *(chunk->packed + word + 1) |= value >> (64 - shift);
+            }
         }
+
+        chunk->base = minimum_value;
+        chunk->bit_width = bit_width;
+        chunk->encoding = PACKED_ENCODING;
     }
     else
     {
-        printf("Fatal error when creating logic item, syntax error for logic comparator %s\n", logic);
-        error_exit("Fatal error when creating logic item, sytax error on comparator\n");
+        return;
     }
 
-    LOGIC_ITEM* item = heapallocate(sizeof(LOGIC_ITEM));
-
-    int column_len = strlen(column);
-
-    item->column_name = copy_string(column, column_len);
-    item->data = copy_string(data, data_size);
-    item->data_size = data_size;
-    item->logic_type = logic_type;
-
-    return item;
+    chunk->encoded_count = count;
+    free_array_list(chunk->rows);
+    chunk->rows = NULL;
 }
 
-int is_true_on_logic(LOGIC_ITEM* logic, TABLE_DECLARATION* table, int index)
+//Brings a compressed chunk back to plain values before it gets modified
+void decompress_int_chunk(COLUMN_CHUNK* chunk)
 {
-    int is_true = 1;
-    char* dummy;
-
-    for(int i = 0; i < table->columns->count; i++)
+    if(chunk->encoding == PLAIN_ENCODING)
     {
-        TABLE_ITEM* table_item = *((TABLE_ITEM**)get_linked_list_data(table->columns, i));
+        return;
+    }
 
-        if(strcmp(table_item->name, logic->column_name) != 0)
-        {
-            continue;
-        }
+    array_list* rows = allocate_array_list(sizeof(int));
+    reserve_array_list(rows, chunk->encoded_count);
 
-        if(table_item->type == INT_TYPE)
-        {
-            int logic_data = strtol(logic->data, &dummy, 10);
-            int table_data = get_linked_list_data_int(table_item->rows, index);
+    for(int i = 0; i < chunk->encoded_count; i++)
+    {
+        add_array_list_int(rows, get_chunk_int(chunk, i));
+    }
 
-            if(logic->logic_type == 0)
-            {
-                if(!(logic_data == table_data))
-                {
-                    is_true = 0;
-                    break;
-                }
-            }
-            else if(logic->logic_type == 1)
-            {
-                if(!(table_data > logic_data))
-                {
-                    is_true = 0;
-                    break;
-                }
-            }
-            else if(logic->logic_type == 2)
-            {
-                if(!(table_data >= logic_data))
-                {
-                    is_true = 0;
-                    break;
-                }
-            }
-            else if(logic->logic_type == 3)
+    if(chunk->runs != NULL)
+    {
+        free_array_list(chunk->runs);
+        chunk->runs = NULL;
+    }
+    free(chunk->packed);
+    chunk->packed = NULL;
+
+    chunk->rows = rows;
+    chunk->encoding = PLAIN_ENCODING;
+    chunk->encoded_count = 0;
+}
+
+//Row addresses encode the row group in the high bits and the offset inside the group in the low bits
+COLUMN_CHUNK* get_column_chunk(TABLE_ITEM* column, int row)
+{
+    return *((COLUMN_CHUNK**)get_array_list_data(column->chunks, row >> ROW_GROUP_SHIFT));
+}
+ROW_GROUP* get_row_group(TABLE_DECLARATION* table, int group)
+{
+    return (ROW_GROUP*)get_array_list_data(table->row_groups, group);
+}
+
+int get_column_int(TABLE_ITEM* column, int row)
+{
+    return get_chunk_int(get_column_chunk(column, row), row & (ROW_GROUP_SIZE - 1));
+}
+float get_column_float(TABLE_ITEM* column, int row)
+{
+    return get_array_list_data_float(get_column_chunk(column, row)->rows, row & (ROW_GROUP_SIZE - 1));
+}
+int get_column_code(TABLE_ITEM* column, int row)
+{
+    void* code = get_array_list_data(get_column_chunk(column, row)->rows, row & (ROW_GROUP_SIZE - 1));
+
+    if(column->row_size == sizeof(unsigned char))
+    {
+        return *((unsigned char*)code);
+    }
+    return *((unsigned short*)code);
+}
+STRING_ENTRY* get_dictionary_value(TABLE_ITEM* column, int row)
+{
+    return (STRING_ENTRY*)get_array_list_data(column->dictionary->values, get_column_code(column, row));
+}
+
+char get_column_char(TABLE_ITEM* column, int row)
+{
+    if(column->dictionary != NULL)
+    {
+        return *(column->dictionary->heap->data + get_dictionary_value(column, row)->offset);
+    }
+    return get_array_list_data_char(get_column_chunk(column, row)->rows, row & (ROW_GROUP_SIZE - 1));
+}
+char* get_column_string(TABLE_ITEM* column, int row)
+{
+    if(column->dictionary != NULL)
+    {
+        return column->dictionary->heap->data + get_dictionary_value(column, row)->offset;
+    }
+
+    COLUMN_CHUNK* chunk = get_column_chunk(column, row);
+    STRING_ENTRY* entry = (STRING_ENTRY*)get_array_list_data(chunk->rows, row & (ROW_GROUP_SIZE - 1));
+
+    return chunk->heap->data + entry->offset;
+}
+int get_column_string_length(TABLE_ITEM* column, int row)
+{
+    if(column->dictionary != NULL)
+    {
+        return get_dictionary_value(column, row)->length;
+    }
+    return ((STRING_ENTRY*)get_array_list_data(get_column_chunk(column, row)->rows, row & (ROW_GROUP_SIZE - 1)))->length;
+}
+
+void set_column_int(TABLE_ITEM* column, int row, int value)
+{
+    COLUMN_CHUNK* chunk = get_column_chunk(column, row);
+
+    decompress_int_chunk(chunk);
+    set_array_list_value_int_at(chunk->rows, row & (ROW_GROUP_SIZE - 1), value);
+}
+void set_column_float(TABLE_ITEM* column, int row, float value)
+{
+    set_array_list_value_float_at(get_column_chunk(column, row)->rows, row & (ROW_GROUP_SIZE - 1), value);
+}
+void set_column_code(TABLE_ITEM* column, int row, int code)
+{
+    COLUMN_CHUNK* chunk = get_column_chunk(column, row);
+
+    if(column->row_size == sizeof(unsigned char))
+    {
+        *((unsigned char*)get_array_list_data(chunk->rows, row & (ROW_GROUP_SIZE - 1))) = (unsigned char)code;
+    }
+    else
+    {
+        *((unsigned short*)get_array_list_data(chunk->rows, row & (ROW_GROUP_SIZE - 1))) = (unsigned short)code;
+    }
+}
+void set_column_char(TABLE_ITEM* column, int row, char value)
+{
+    if(column->dictionary != NULL)
+    {
+        set_column_code(column, row, get_dictionary_code(column, &value, 1));
+        return;
+    }
+    set_array_list_value_char_at(get_column_chunk(column, row)->rows, row & (ROW_GROUP_SIZE - 1), value);
+}
+void set_column_string(TABLE_ITEM* column, int row, char* value)
+{
+    if(column->dictionary != NULL)
+    {
+        int code = get_dictionary_string_code(column, value);
+        if(code != -1)
+        {
+            set_column_code(column, row, code);
+            return;
+        }
+    }
+
+    COLUMN_CHUNK* chunk = get_column_chunk(column, row);
+    STRING_ENTRY* entry = (STRING_ENTRY*)get_array_list_data(chunk->rows, row & (ROW_GROUP_SIZE - 1));
+
+    chunk->heap_garbage += entry->length + 1;
+
+    STRING_ENTRY update = push_chunk_string(column, chunk, value);
+    set_array_list_value_at(chunk->rows, row & (ROW_GROUP_SIZE - 1), &update);
+
+    compact_chunk_heap(chunk);
+}
+
+//Returns the address of the first live row after row, skipping deleted slots, or -1 when there is none
+int get_next_table_row(TABLE_DECLARATION* table, int row)
+{
+    int group = 0;
+    int offset = 0;
+
+    if(row >= 0)
+    {
+        group = row >> ROW_GROUP_SHIFT;
+        offset = (row & (ROW_GROUP_SIZE - 1)) + 1;
+    }
+
+    while (group < table->row_groups->count)
+    {
+        ROW_GROUP* row_group = get_row_group(table, group);
+
+        if(row_group->live_count == row_group->row_count)
+        {
+            if(offset < row_group->row_count)
             {
-                if(!(table_data < logic_data))
-                {
-                    is_true = 0;
-                    break;
-                }
+                return (group << ROW_GROUP_SHIFT) + offset;
             }
-            else if(logic->logic_type == 4)
+        }
+        else
+        {
+            while (offset < row_group->row_count)
             {
-                if(!(table_data <= logic_data))
+                unsigned long long word = row_group->deleted[offset >> 6];
+
+                //Skips whole words of deleted rows at once
+                if(word == ~0ull && (offset & 63) == 0)
                 {
-                    is_true = 0;
-                    break;
+                    offset += 64;
+                    continue;
                 }
-            }
-            else if(logic->logic_type == 5)
-            {
-                if(!(table_data != logic_data))
+                if(((word >> (offset & 63)) & 1) == 0)
                 {
-                    is_true = 0;
-                    break;
+                    return (group << ROW_GROUP_SHIFT) + offset;
                 }
+                offset++;
             }
         }
-        else if(table_item->type == FLOAT_TYPE)
+
+        group++;
+        offset = 0;
+    }
+
+    return -1;
+}
+//Returns the first row address of the table, or -1 when the table is empty
+int get_first_table_row(TABLE_DECLARATION* table)
+{
+    return get_next_table_row(table, -1);
+}
+
+//Converts the index of a row as seen by the user into its row address, walking whole row groups at a time
+int get_table_row_at(TABLE_DECLARATION* table, int index)
+{
+    if(index < 0 || index >= table->row_count)
+    {
+        return -1;
+    }
+
+    for(int group = 0; group < table->row_groups->count; group++)
+    {
+        ROW_GROUP* row_group = get_row_group(table, group);
+        if(index >= row_group->live_count)
         {
-            float logic_data = strtof(logic->data, &dummy);
-            float table_data = get_linked_list_data_float(table_item->rows, index);
+            index -= row_group->live_count;
+            continue;
+        }
 
-            if(logic->logic_type == 0)
-            {
-                if(!(logic_data == table_data))
-                {
-                    is_true = 0;
-                    break;
-                }
-            }
-            else if(logic->logic_type == 1)
-            {
-                if(!(table_data > logic_data))
-                {
-                    is_true = 0;
-                    break;
-                }
-            }
-            else if(logic->logic_type == 2)
-            {
-                if(!(table_data >= logic_data))
-                {
-                    is_true = 0;
-                    break;
-                }
-            }
-            else if(logic->logic_type == 3)
-            {
-                if(!(table_data < logic_data))
-                {
-                    is_true = 0;
-                    break;
-                }
-            }
-            else if(logic->logic_type == 4)
-            {
-                if(!(table_data <= logic_data))
-                {
-                    is_true = 0;
-                    break;
-                }
-            }
-            else if(logic->logic_type == 5)
+        if(row_group->live_count == row_group->row_count)
+        {
+            return (group << ROW_GROUP_SHIFT) + index;
+        }
+        for(int offset = 0; offset < row_group->row_count; offset++)
+        {
+            if(((row_group->deleted[offset >> 6] >> (offset & 63)) & 1) == 0)
             {
-                if(!(table_data != logic_data))
+                if(index == 0)
                 {
-                    is_true = 0;
-                    break;
+                    return (group << ROW_GROUP_SHIFT) + offset;
                 }
+                index--;
             }
         }
-        else if(table_item->type == CHAR_TYPE)
+    }
+
+    return -1;
+}
+
+int get_column_index(TABLE_DECLARATION* table, const char* name)
+{
+    int* column_index = (int*)get_hash_map_data(table->column_lookup, name, strlen(name));
+    if(column_index == NULL)
+    {
+        return -1;
+    }
+
+    return *column_index;
+}
+int get_table_index(TABLE_CATALOG* catalog, const char* name)
+{
+    int* table_index = (int*)get_hash_map_data(catalog->lookup, name, strlen(name));
+    if(table_index == NULL)
+    {
+        return -1;
+    }
+    
+    return *table_index;
+}
+
+TABLE_DECLARATION* create_table_declaration(char* name)
+{
+    TABLE_DECLARATION* table = heapallocate(sizeof(TABLE_DECLARATION));
+    table->name = name;
+    table->columns = allocate_array_list(sizeof(TABLE_ITEM*));
+    table->column_lookup = allocate_hash_map(sizeof(int));
+    table->row_count = 0;
+    table->deleted_count = 0;
+    table->row_groups = allocate_array_list(sizeof(ROW_GROUP));
+    table->primary_index = NULL;
+    table->key_buffer = allocate_array_list(sizeof(char));
+
+    return table;
+}
+
+void add_column_int(TABLE_ITEM* column, int row, int value)
+{
+    COLUMN_CHUNK* chunk = get_column_chunk(column, row);
+
+    decompress_int_chunk(chunk);
+    add_array_list_int(chunk->rows, value);
+}
+void add_column_float(TABLE_ITEM* column, int row, float value)
+{
+    add_array_list_float(get_column_chunk(column, row)->rows, value);
+}
+void add_column_code(TABLE_ITEM* column, int row, int code)
+{
+    COLUMN_CHUNK* chunk = get_column_chunk(column, row);
+
+    if(column->row_size == sizeof(unsigned char))
+    {
+        unsigned char small_code = (unsigned char)code;
+        add_array_list_value(chunk->rows, &small_code);
+    }
+    else
+    {
+        unsigned short wide_code = (unsigned short)code;
+        add_array_list_value(chunk->rows, &wide_code);
+    }
+}
+void add_column_char(TABLE_ITEM* column, int row, char value)
+{
+    if(column->dictionary != NULL)
+    {
+        add_column_code(column, row, get_dictionary_code(column, &value, 1));
+        return;
+    }
+    add_array_list_char(get_column_chunk(column, row)->rows, value);
+}
+void add_column_string(TABLE_ITEM* column, int row, char* value)
+{
+    if(column->dictionary != NULL)
+    {
+        int code = get_dictionary_string_code(column, value);
+        if(code != -1)
+        {
+            add_column_code(column, row, code);
+            return;
+        }
+    }
+
+    COLUMN_CHUNK* chunk = get_column_chunk(column, row);
+    STRING_ENTRY entry = push_chunk_string(column, chunk, value);
+
+    add_array_list_value(chunk->rows, &entry);
+}
+
+//Values as they end up stored in a column, shared by inserts, updates and key lookups
+char get_char_value(char* data, int data_size)
+{
+    if(data_size > 0)
+    {
+        return *(data);
+    }
+
+    return ' ';
+}
+int get_string_value_length(TABLE_ITEM* column, char* data)
+{
+    int length = strlen(data);
+    if(length > column->data_size)
+    {
+        length = column->data_size;
+    }
+
+    return length;
+}
+
+//Keys are column values serialized one after another, strings keep their terminator so composite
+//keys cannot run into each other. A NaN never equals anything, so keys holding one are not indexed
+int add_key_int(array_list* key, int value)
+{
+    reserve_array_list(key, key->count + sizeof(int));
+    memcpy(key->data + key->count, &value, sizeof(int));
+    key->count += sizeof(int);
+
+    return 1;
+}
+int add_key_float(array_list* key, float value)
+{
+    if(value != value)
+    {
+        return 0;
+    }
+    if(value == 0)
+    {
+        value = 0;
+    }
+
+    reserve_array_list(key, key->count + sizeof(float));
+    memcpy(key->data + key->count, &value, sizeof(float));
+    key->count += sizeof(float);
+
+    return 1;
+}
+int add_key_string(array_list* key, char* value, int length)
+{
+    reserve_array_list(key, key->count + length + 1);
+    memcpy(key->data + key->count, value, length);
+    *(key->data + key->count + length) = '\0';
+    key->count += length + 1;
+
+    return 1;
+}
+int add_key_row(array_list* key, TABLE_ITEM* column, int row)
+{
+    if(column->type == INT_TYPE)
+    {
+        return add_key_int(key, get_column_int(column, row));
+    }
+    else if(column->type == FLOAT_TYPE)
+    {
+        return add_key_float(key, get_column_float(column, row));
+    }
+    else if(column->type == CHAR_TYPE)
+    {
+        char value = get_column_char(column, row);
+        return add_key_string(key, &value, 1);
+    }
+
+    return add_key_string(key, get_column_string(column, row), get_column_string_length(column, row));
+}
+int add_key_data(array_list* key, TABLE_ITEM* column, char* data, int data_size)
+{
+    char* dummy;
+
+    if(column->type == INT_TYPE)
+    {
+        return add_key_int(key, strtol(data, &dummy, 10));
+    }
+    else if(column->type == FLOAT_TYPE)
+    {
+        return add_key_float(key, strtof(data, &dummy));
+    }
+    else if(column->type == CHAR_TYPE)
+    {
+        char value = get_char_value(data, data_size);
+        return add_key_string(key, &value, 1);
+    }
+
+    return add_key_string(key, data, get_string_value_length(column, data));
+}
+
+//Value counts map a serialized value to how many rows hold it, values whose count drops to zero are removed
+void add_key_count(hash_map* counts, array_list* key, int amount)
+{
+    int* count = (int*)get_hash_map_data(counts, key->data, key->count);
+    if(count == NULL)
+    {
+        put_hash_map_value(counts, key->data, key->count, &amount);
+    }
+    else if(*count + amount == 0)
+    {
+        remove_hash_map_value(counts, key->data, key->count);
+    }
+    else
+    {
+        *count += amount;
+    }
+}
+//Kept on columns referenced by a foreign key, counts the live rows of the column's own table
+void add_column_value_count(TABLE_DECLARATION* table, TABLE_ITEM* column, int row, int amount)
+{
+    clear_array_list(table->key_buffer);
+    if(add_key_row(table->key_buffer, column, row))
+    {
+        add_key_count(column->value_counts, table->key_buffer, amount);
+    }
+}
+//Counts on the referenced column how many rows of other tables point at each of its values
+void add_column_reference_count(TABLE_DECLARATION* table, TABLE_ITEM* column, int row, int amount)
+{
+    clear_array_list(table->key_buffer);
+    if(add_key_row(table->key_buffer, column, row))
+    {
+        add_key_count(column->foreign_column->reference_counts, table->key_buffer, amount);
+    }
+}
+void make_value_count_column(TABLE_DECLARATION* table, TABLE_ITEM* column)
+{
+    if(column->value_counts != NULL)
+    {
+        return;
+    }
+
+    column->value_counts = allocate_hash_map(sizeof(int));
+    for(int r = get_first_table_row(table); r != -1; r = get_next_table_row(table, r))
+    {
+        add_column_value_count(table, column, r, 1);
+    }
+}
+//Looks the serialized value in key up, returning how many rows hold it
+int get_key_count(hash_map* counts, array_list* key)
+{
+    int* count = (int*)get_hash_map_data(counts, key->data, key->count);
+    if(count == NULL)
+    {
+        return 0;
+    }
+
+    return *count;
+}
+
+//Ordered index keys are the raw column value, strings are padded with zeros up to the column size
+int compare_int_key(const void* left, const void* right)
+{
+    int left_value = *((int*)left);
+    int right_value = *((int*)right);
+
+    return (left_value > right_value) - (left_value < right_value);
+}
+int compare_float_key(const void* left, const void* right)
+{
+    float left_value = *((float*)left);
+    float right_value = *((float*)right);
+
+    return (left_value > right_value) - (left_value < right_value);
+}
+int compare_char_key(const void* left, const void* right)
+{
+    char left_value = *((char*)left);
+    char right_value = *((char*)right);
+
+    return (left_value > right_value) - (left_value < right_value);
+}
+int compare_string_key(const void* left, const void* right)
+{
+    return strcmp((const char*)left, (const char*)right);
+}
+btree_compare get_column_key_compare(TABLE_ITEM* column)
+{
+    if(column->type == INT_TYPE)
+    {
+        return compare_int_key;
+    }
+    else if(column->type == FLOAT_TYPE)
+    {
+        return compare_float_key;
+    }
+    else if(column->type == CHAR_TYPE)
+    {
+        return compare_char_key;
+    }
+
+    return compare_string_key;
+}
+//Builds the ordered key of a stored row in the table's key buffer, NaN cannot be ordered so it is left out
+int build_ordered_row_key(TABLE_DECLARATION* table, TABLE_ITEM* column, int row)
+{
+    int key_size = get_column_key_size(column);
+
+    clear_array_list(table->key_buffer);
+    reserve_array_list(table->key_buffer, key_size);
+    memset(table->key_buffer->data, 0, key_size);
+
+    if(column->type == INT_TYPE)
+    {
+        int value = get_column_int(column, row);
+        memcpy(table->key_buffer->data, &value, sizeof(int));
+    }
+    else if(column->type == FLOAT_TYPE)
+    {
+        float value = get_column_float(column, row);
+        if(value != value)
+        {
+            return 0;
+        }
+        memcpy(table->key_buffer->data, &value, sizeof(float));
+    }
+    else if(column->type == CHAR_TYPE)
+    {
+        *(table->key_buffer->data) = get_column_char(column, row);
+    }
+    else
+    {
+        memcpy(table->key_buffer->data, get_column_string(column, row), get_column_string_length(column, row));
+    }
+
+    return 1;
+}
+void add_ordered_index_row(TABLE_DECLARATION* table, TABLE_ITEM* column, int row)
+{
+    if(build_ordered_row_key(table, column, row))
+    {
+        insert_btree_value(column->ordered_index, table->key_buffer->data, row);
+    }
+}
+void remove_ordered_index_row(TABLE_DECLARATION* table, TABLE_ITEM* column, int row)
+{
+    if(build_ordered_row_key(table, column, row))
+    {
+        remove_btree_value(column->ordered_index, table->key_buffer->data, row);
+    }
+}
+void rebuild_ordered_index(TABLE_DECLARATION* table, TABLE_ITEM* column)
+{
+    clear_btree(column->ordered_index);
+    for(int r = get_first_table_row(table); r != -1; r = get_next_table_row(table, r))
+    {
+        add_ordered_index_row(table, column, r);
+    }
+}
+bitmap* get_bitmap_index_rows(BITMAP_INDEX* index, int value_index)
+{
+    return *((bitmap**)get_array_list_data(index->bitmaps, value_index));
+}
+//Values seen for the first time get their own bitmap, bitmaps left empty are kept for when the value comes back
+void add_bitmap_index_row(TABLE_DECLARATION* table, TABLE_ITEM* column, int row)
+{
+    BITMAP_INDEX* index = column->bitmap_index;
+    build_ordered_row_key(table, column, row);
+
+    int* value_index = (int*)get_hash_map_data(index->lookup, table->key_buffer->data, index->keys->data_size);
+    if(value_index == NULL)
+    {
+        int new_index = index->bitmaps->count;
+        bitmap* rows = allocate_bitmap();
+
+        add_array_list_value(index->keys, table->key_buffer->data);
+        add_array_list_value(index->bitmaps, &rows);
+        value_index = (int*)put_hash_map_value(index->lookup, table->key_buffer->data, index->keys->data_size, &new_index);
+    }
+
+    add_bitmap_value(get_bitmap_index_rows(index, *value_index), row);
+}
+void remove_bitmap_index_row(TABLE_DECLARATION* table, TABLE_ITEM* column, int row)
+{
+    BITMAP_INDEX* index = column->bitmap_index;
+    build_ordered_row_key(table, column, row);
+
+    int* value_index = (int*)get_hash_map_data(index->lookup, table->key_buffer->data, index->keys->data_size);
+    if(value_index != NULL)
+    {
+        remove_bitmap_value(get_bitmap_index_rows(index, *value_index), row);
+    }
+}
+void clear_bitmap_index(BITMAP_INDEX* index)
+{
+    for(int i = 0; i < index->bitmaps->count; i++)
+    {
+        clear_bitmap(get_bitmap_index_rows(index, i));
+    }
+}
+void rebuild_bitmap_index(TABLE_DECLARATION* table, TABLE_ITEM* column)
+{
+    clear_bitmap_index(column->bitmap_index);
+    for(int r = get_first_table_row(table); r != -1; r = get_next_table_row(table, r))
+    {
+        add_bitmap_index_row(table, column, r);
+    }
+}
+void make_bitmap_index_column(TABLE_DECLARATION* table, TABLE_ITEM* column)
+{
+    column->bitmap_index = heapallocate(sizeof(BITMAP_INDEX));
+    column->bitmap_index->keys = allocate_array_list(get_column_key_size(column));
+    column->bitmap_index->bitmaps = allocate_array_list(sizeof(bitmap*));
+    column->bitmap_index->lookup = allocate_hash_map(sizeof(int));
+
+    rebuild_bitmap_index(table, column);
+}
+//Widens the zone of the row's chunk to hold its current value
+void widen_chunk_zone(TABLE_DECLARATION* table, TABLE_ITEM* column, int row)
+{
+    COLUMN_CHUNK* chunk = get_column_chunk(column, row);
+    if(!build_ordered_row_key(table, column, row))
+    {
+        chunk->has_unordered = 1;
+        return;
+    }
+
+    char* key = table->key_buffer->data;
+    int key_size = get_column_key_size(column);
+    btree_compare compare = get_column_key_compare(column);
+
+    if(chunk->zone_count == 0 || compare(key, chunk->zone_min) < 0)
+    {
+        memcpy(chunk->zone_min, key, key_size);
+    }
+    if(chunk->zone_count == 0 || compare(key, chunk->zone_max) > 0)
+    {
+        memcpy(chunk->zone_max, key, key_size);
+    }
+    chunk->zone_count++;
+}
+void make_ordered_index_column(TABLE_DECLARATION* table, TABLE_ITEM* column)
+{
+    column->ordered_index = allocate_btree(get_column_key_size(column), get_column_key_compare(column));
+    rebuild_ordered_index(table, column);
+}
+
+void add_table_item(TABLE_CATALOG* tables, TABLE_DECLARATION* declaration, TABLE_ITEM* item, int is_primary, int is_foreign, char* foreign_target_table, char* foreign_target_column)
+{
+    if(get_column_index(declaration, item->name) != -1)
+    {
+        printf("Fatal error when adding column : %s, in table %s\n", item->name, declaration->name);
+        error_exit("Fatal error when adding column, a column with the same name already exist\n");
+    }
+
+    for(int i = 0; i < declaration->row_groups->count; i++)
+    {
+        COLUMN_CHUNK* chunk = create_column_chunk(item);
+        int row = i << ROW_GROUP_SHIFT;
+        int row_count = get_row_group(declaration, i)->row_count;
+
+        add_array_list_value(item->chunks, &chunk);
+        reserve_array_list(chunk->rows, row_count);
+        for(int j = 0; j < row_count; j++)
+        {
+            if(item->type == INT_TYPE)
+            {
+                add_column_int(item, row, 0);
+            }
+            else if(item->type == FLOAT_TYPE)
+            {
+                add_column_float(item, row, 0);
+            }
+            else if(item->type == CHAR_TYPE)
+            {
+                add_column_char(item, row, '\0');
+            }
+            else if(item->type == VARCHAR_TYPE)
+            {
+                add_column_string(item, row, "");
+            }
+        }
+    }
+
+    item->is_primary = is_primary;
+    item->is_foreign = is_foreign;
+    item->foreign_target_table = foreign_target_table;
+    item->foreign_target_column = foreign_target_column;
+    
+    if(is_primary)
+    {
+        if(declaration->row_count > 0)
+        {
+            printf("Fatal error when adding column : %s, in table %s\n", item->name, declaration->name);
+            error_exit("Fatal error when adding column, column cannot be made primary since row count is already higher than 0\n");
+        }
+    }
+    if(is_foreign)
+    {
+        int table_index = get_table_index(tables, foreign_target_table);
+        if(table_index == -1)
+        {
+            printf("Fatal error when adding column : %s, in table %s, foreign %s\n", item->name, declaration->name, foreign_target_table);
+            error_exit("Fatal error when adding column, column cannot be made foreign because there is no table with such foreign name\n");
+        }
+        int column_index = get_column_index(*((TABLE_DECLARATION**)get_array_list_data(tables->declarations, table_index)), foreign_target_column);
+        if(column_index == -1)
+        {
+            printf("Fatal error when adding column : %s, in table %s, foreign %s column foreign %s\n", item->name, declaration->name, foreign_target_table, foreign_target_column);
+            error_exit("Fatal error when adding column, column cannot be made foreign because there is no column with such foreign name in foreign table\n");
+        }
+
+        TABLE_DECLARATION* foreign_table = *((TABLE_DECLARATION**)get_array_list_data(tables->declarations, table_index));
+        TABLE_ITEM* foreign_column = *((TABLE_ITEM**)get_array_list_data(foreign_table->columns, column_index));
+
+        if(foreign_column->type != item->type || foreign_column->data_size != item->data_size)
+        {
+            printf("Fatal error when adding column : %s, in table %s, foreign %s column foreign %s\n", item->name, declaration->name, foreign_target_table, foreign_target_column);
+            error_exit("Fatal error when adding column, incorect data type to foreign other table\n");
+        }
+        if(foreign_column->is_primary == 0)
+        {
+            printf("Fatal error when adding column : %s, in table %s, foreign %s column foreign %s\n", item->name, declaration->name, foreign_target_table, foreign_target_column);
+            error_exit("Fatal error when adding column, foreign target is not a primary atribute\n");
+        }
+
+        item->foreign_table = foreign_table;
+        item->foreign_column = foreign_column;
+        make_value_count_column(foreign_table, foreign_column);
+        if(foreign_column->reference_counts == NULL)
+        {
+            foreign_column->reference_counts = allocate_hash_map(sizeof(int));
+        }
+
+        if(declaration->row_count > 0)
+        {
+            printf("Fatal error when adding column : %s, in table %s\n", item->name, declaration->name);
+            error_exit("Fatal error when adding column, column cannot be made foreign since row count is already higher than 0\n");
+        }
+    }
+
+    int column_index = declaration->columns->count;
+    add_array_list_value(declaration->columns, &item);
+    put_hash_map_value(declaration->column_lookup, item->name, strlen(item->name), &column_index);
+
+    if(is_primary && declaration->primary_index == NULL)
+    {
+        declaration->primary_index = allocate_hash_map(sizeof(int));
+    }
+}
+
+//Builds the key of a stored row in the table's key buffer, returns 0 when the key cannot be indexed
+int build_primary_row_key(TABLE_DECLARATION* table, int row)
+{
+    clear_array_list(table->key_buffer);
+    for(int i = 0; i < table->columns->count; i++)
+    {
+        TABLE_ITEM* column = *((TABLE_ITEM**)get_array_list_data(table->columns, i));
+        if(column->is_primary && !add_key_row(table->key_buffer, column, row))
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+//Same as build_primary_row_key for the raw values of a row about to be inserted
+int build_primary_data_key(TABLE_DECLARATION* table, char** data, int* data_size)
+{
+    clear_array_list(table->key_buffer);
+    for(int i = 0; i < table->columns->count; i++)
+    {
+        TABLE_ITEM* column = *((TABLE_ITEM**)get_array_list_data(table->columns, i));
+        if(column->is_primary && !add_key_data(table->key_buffer, column, *(data + i), *(data_size + i)))
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+//Key of a stored row once the update items are applied to it
+int build_primary_update_key(TABLE_DECLARATION* table, linked_list* update_items, int row)
+{
+    clear_array_list(table->key_buffer);
+    for(int i = 0; i < table->columns->count; i++)
+    {
+        TABLE_ITEM* column = *((TABLE_ITEM**)get_array_list_data(table->columns, i));
+        if(!column->is_primary)
+        {
+            continue;
+        }
+
+        UPDATE_ITEM* update = NULL;
+        for(int j = 0; j < update_items->count; j++)
+        {
+            UPDATE_ITEM* current_update = *((UPDATE_ITEM**)get_linked_list_data(update_items, j));
+            if(current_update->column_index == i)
+            {
+                update = current_update;
+            }
+        }
+
+        int is_indexed = update != NULL ? add_key_data(table->key_buffer, column, update->data, update->data_size) : add_key_row(table->key_buffer, column, row);
+        if(!is_indexed)
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+void add_primary_index_row(TABLE_DECLARATION* table, int row)
+{
+    if(table->primary_index != NULL && build_primary_row_key(table, row))
+    {
+        put_hash_map_value(table->primary_index, table->key_buffer->data, table->key_buffer->count, &row);
+    }
+}
+void remove_primary_index_row(TABLE_DECLARATION* table, int row)
+{
+    if(table->primary_index == NULL || !build_primary_row_key(table, row))
+    {
+        return;
+    }
+
+    int* indexed_row = (int*)get_hash_map_data(table->primary_index, table->key_buffer->data, table->key_buffer->count);
+    if(indexed_row != NULL && *indexed_row == row)
+    {
+        remove_hash_map_value(table->primary_index, table->key_buffer->data, table->key_buffer->count);
+    }
+}
+
+//Adds or removes a live row from every index of its table
+void index_table_row(TABLE_DECLARATION* table, int row)
+{
+    add_primary_index_row(table, row);
+    for(int i = 0; i < table->columns->count; i++)
+    {
+        TABLE_ITEM* column = *((TABLE_ITEM**)get_array_list_data(table->columns, i));
+        widen_chunk_zone(table, column, row);
+        if(column->value_counts != NULL)
+        {
+            add_column_value_count(table, column, row, 1);
+        }
+        if(column->foreign_column != NULL)
+        {
+            add_column_reference_count(table, column, row, 1);
+        }
+        if(column->ordered_index != NULL)
+        {
+            add_ordered_index_row(table, column, row);
+        }
+        if(column->bitmap_index != NULL)
+        {
+            add_bitmap_index_row(table, column, row);
+        }
+    }
+}
+void unindex_table_row(TABLE_DECLARATION* table, int row)
+{
+    remove_primary_index_row(table, row);
+    for(int i = 0; i < table->columns->count; i++)
+    {
+        TABLE_ITEM* column = *((TABLE_ITEM**)get_array_list_data(table->columns, i));
+        if(column->value_counts != NULL)
+        {
+            add_column_value_count(table, column, row, -1);
+        }
+        if(column->foreign_column != NULL)
+        {
+            add_column_reference_count(table, column, row, -1);
+        }
+        if(column->ordered_index != NULL)
+        {
+            remove_ordered_index_row(table, column, row);
+        }
+        if(column->bitmap_index != NULL)
+        {
+            remove_bitmap_index_row(table, column, row);
+        }
+    }
+}
+void rebuild_primary_index(TABLE_DECLARATION* table)
+{
+    if(table->primary_index == NULL)
+    {
+        return;
+    }
+
+    clear_hash_map(table->primary_index);
+    for(int r = get_first_table_row(table); r != -1; r = get_next_table_row(table, r))
+    {
+        add_primary_index_row(table, r);
+    }
+}
+
+//Returns the row address the next inserted row will take, opening a new row group when the last one is full
+int get_table_insert_row(TABLE_DECLARATION* table)
+{
+    int group_count = table->row_groups->count;
+    if(group_count > 0 && get_row_group(table, group_count - 1)->row_count < ROW_GROUP_SIZE)
+    {
+        return ((group_count - 1) << ROW_GROUP_SHIFT) + get_row_group(table, group_count - 1)->row_count;
+    }
+
+    ROW_GROUP group;
+    group.row_count = 0;
+    group.live_count = 0;
+    memset(group.deleted, 0, sizeof(group.deleted));
+    add_array_list_value(table->row_groups, &group);
+
+    for(int i = 0; i < table->columns->count; i++)
+    {
+        TABLE_ITEM* column = *((TABLE_ITEM**)get_array_list_data(table->columns, i));
+        COLUMN_CHUNK* chunk = create_column_chunk(column);
+
+        add_array_list_value(column->chunks, &chunk);
+    }
+
+    return group_count << ROW_GROUP_SHIFT;
+}
+//Called once every column received the value of the row returned by get_table_insert_row
+void commit_table_insert_row(TABLE_DECLARATION* table)
+{
+    int group_index = table->row_groups->count - 1;
+    ROW_GROUP* group = get_row_group(table, group_index);
+
+    group->row_count += 1;
+    group->live_count += 1;
+    table->row_count += 1;
+    index_table_row(table, (group_index << ROW_GROUP_SHIFT) + group->row_count - 1);
+
+    //A full row group is sealed by compressing its INT chunks
+    if(group->row_count == ROW_GROUP_SIZE)
+    {
+        for(int i = 0; i < table->columns->count; i++)
+        {
+            TABLE_ITEM* column = *((TABLE_ITEM**)get_array_list_data(table->columns, i));
+            if(column->type == INT_TYPE)
+            {
+                compress_int_chunk(*((COLUMN_CHUNK**)get_array_list_data(column->chunks, group_index)));
+            }
+        }
+    }
+}
+
+//Only marks the row as deleted, row addresses stay valid until the table is vacuumed
+void delete_table_row(TABLE_DECLARATION* table, int row)
+{
+    int group = row >> ROW_GROUP_SHIFT;
+    int offset = row & (ROW_GROUP_SIZE - 1);
+
+    if(row < 0 || group >= table->row_groups->count || offset >= get_row_group(table, group)->row_count)
+    {
+        printf("Fatal error when deleting row : %i, in table %s\n", row, table->name);
+        error_exit("Fatal error when deleting row, index is outside bounds of the rows\n");
+    }
+
+    ROW_GROUP* row_group = get_row_group(table, group);
+    unsigned long long bit = 1ull << (offset & 63);
+
+    if(row_group->deleted[offset >> 6] & bit)
+    {
+        printf("Fatal error when deleting row : %i, in table %s\n", row, table->name);
+        error_exit("Fatal error when deleting row, row is already deleted\n");
+    }
+
+    unindex_table_row(table, row);
+    row_group->deleted[offset >> 6] |= bit;
+    row_group->live_count -= 1;
+    table->row_count -= 1;
+    table->deleted_count += 1;
+}
+
+//Removes the deleted rows from every chunk in a single pass and drops row groups left empty
+void vacuum_table(TABLE_DECLARATION* table)
+{
+    if(table->deleted_count == 0)
+    {
+        return;
+    }
+
+    int group = 0;
+    while (group < table->row_groups->count)
+    {
+        ROW_GROUP* row_group = get_row_group(table, group);
+
+        if(row_group->live_count == row_group->row_count)
+        {
+            group++;
+            continue;
+        }
+
+        for(int i = 0; i < table->columns->count; i++)
+        {
+            TABLE_ITEM* table_item = *((TABLE_ITEM**)get_array_list_data(table->columns, i));
+            COLUMN_CHUNK* chunk = *((COLUMN_CHUNK**)get_array_list_data(table_item->chunks, group));
+
+            if(row_group->live_count == 0)
+            {
+                free_column_chunk(chunk);
+                remove_array_list_value_at(table_item->chunks, group);
+                continue;
+            }
+
+            if(table_item->type == INT_TYPE)
+            {
+                decompress_int_chunk(chunk);
+            }
+
+            int kept = 0;
+            for(int offset = 0; offset < row_group->row_count; offset++)
+            {
+                char* data = chunk->rows->data + offset * chunk->rows->data_size;
+
+                if((row_group->deleted[offset >> 6] >> (offset & 63)) & 1)
+                {
+                    if(chunk->heap != NULL)
+                    {
+                        chunk->heap_garbage += ((STRING_ENTRY*)data)->length + 1;
+                    }
+                    continue;
+                }
+                if(kept != offset)
+                {
+                    memcpy(chunk->rows->data + kept * chunk->rows->data_size, data, chunk->rows->data_size);
+                }
+                kept++;
+            }
+            chunk->rows->count = kept;
+
+            if(chunk->heap != NULL)
+            {
+                compact_chunk_heap(chunk);
+            }
+            //Only the last row group still receives inserts, the others can be compressed again right away
+            if(table_item->type == INT_TYPE && group < table->row_groups->count - 1)
+            {
+                compress_int_chunk(chunk);
+            }
+        }
+
+        if(row_group->live_count == 0)
+        {
+            remove_array_list_value_at(table->row_groups, group);
+            continue;
+        }
+
+        row_group->row_count = row_group->live_count;
+        memset(row_group->deleted, 0, sizeof(row_group->deleted));
+
+        //Zones are rebuilt from the rows left so they tighten again
+        for(int i = 0; i < table->columns->count; i++)
+        {
+            TABLE_ITEM* table_item = *((TABLE_ITEM**)get_array_list_data(table->columns, i));
+            COLUMN_CHUNK* chunk = *((COLUMN_CHUNK**)get_array_list_data(table_item->chunks, group));
+
+            chunk->zone_count = 0;
+            chunk->has_unordered = 0;
+            for(int offset = 0; offset < row_group->row_count; offset++)
+            {
+                widen_chunk_zone(table, table_item, (group << ROW_GROUP_SHIFT) + offset);
+            }
+        }
+        group++;
+    }
+
+    table->deleted_count = 0;
+    rebuild_primary_index(table);
+
+    //Secondary indexes hold row addresses, which compaction just moved
+    for(int i = 0; i < table->columns->count; i++)
+    {
+        TABLE_ITEM* column = *((TABLE_ITEM**)get_array_list_data(table->columns, i));
+        if(column->ordered_index != NULL)
+        {
+            rebuild_ordered_index(table, column);
+        }
+        if(column->bitmap_index != NULL)
+        {
+            rebuild_bitmap_index(table, column);
+        }
+    }
+}
+
+//Deleted rows are reclaimed once they take as much room as the rows still alive
+void vacuum_table_on_threshold(TABLE_DECLARATION* table)
+{
+    if(table->deleted_count >= ROW_GROUP_SIZE && table->deleted_count >= table->row_count)
+    {
+        vacuum_table(table);
+    }
+}
+
+//Drops every row of the table at once
+void clear_table_rows(TABLE_DECLARATION* table)
+{
+    for(int i = 0; i < table->columns->count; i++)
+    {
+        TABLE_ITEM* column = *((TABLE_ITEM**)get_array_list_data(table->columns, i));
+        if(column->foreign_column == NULL)
+        {
+            continue;
+        }
+
+        for(int r = get_first_table_row(table); r != -1; r = get_next_table_row(table, r))
+        {
+            add_column_reference_count(table, column, r, -1);
+        }
+    }
+
+    for(int i = 0; i < table->columns->count; i++)
+    {
+        TABLE_ITEM* table_item = *((TABLE_ITEM**)get_array_list_data(table->columns, i));
+        for(int j = 0; j < table_item->chunks->count; j++)
+        {
+            free_column_chunk(*((COLUMN_CHUNK**)get_array_list_data(table_item->chunks, j)));
+        }
+        clear_array_list(table_item->chunks);
+    }
+
+    clear_array_list(table->row_groups);
+    table->row_count = 0;
+    table->deleted_count = 0;
+    if(table->primary_index != NULL)
+    {
+        clear_hash_map(table->primary_index);
+    }
+    for(int i = 0; i < table->columns->count; i++)
+    {
+        TABLE_ITEM* column = *((TABLE_ITEM**)get_array_list_data(table->columns, i));
+        if(column->value_counts != NULL)
+        {
+            clear_hash_map(column->value_counts);
+        }
+        if(column->ordered_index != NULL)
+        {
+            clear_btree(column->ordered_index);
+        }
+        if(column->bitmap_index != NULL)
+        {
+            clear_bitmap_index(column->bitmap_index);
+        }
+    }
+}
+
+LOGIC_ITEM* create_logic_item(arena* memory, TABLE_DECLARATION* table, char* column, char* logic, int logic_size, char* data, int data_size)
+{
+    int column_index = get_column_index(table, column);
+    if(column_index == -1)
+    {
+        printf("Fatal error when creating logic item, cannot find column %s on table %s\n", column, table->name);
+        error_exit("Fatal error when creating logic item, cannot find associated column in table\n");
+    }
+    if(logic_size > 2)
+    {
+        printf("Fatal error when creating logic item, syntax error for logic comparator %s\n", logic);
+        error_exit("Fatal error when creating logic item, sytax error on comparator\n");
+    }
+
+    int logic_type = 0;
+    char first_character = *(logic);
+    if(first_character == '=' && logic_size == 1)
+    {
+        logic_type = 0;
+    }
+    else if(first_character == '>')
+    {
+        logic_type = 1;
+        if(logic_size == 2)
+        {
+            if(*(logic + 1) == '=')
+            {
+                logic_type = 2;
+            }
+            else
+            {
+                printf("Fatal error when creating logic item, syntax error for logic comparator %s\n", logic);
+                error_exit("Fatal error when creating logic item, sytax error on comparator\n");
+            }
+        }
+    }
+    else if(first_character == '<')
+    {
+        logic_type = 3;
+        if(logic_size == 2)
+        {
+            if(*(logic + 1) == '=')
+            {
+                logic_type = 4;
+            }
+            else
+            {
+                printf("Fatal error when creating logic item, syntax error for logic comparator %s\n", logic);
+                error_exit("Fatal error when creating logic item, sytax error on comparator\n");
+            }
+        }
+    }
+    else if(first_character == '!')
+    {
+        if(logic_size == 2 && *(logic + 1) == '=')
+        {
+            logic_type = 5;
+        }
+        else
+        {
+            printf("Fatal error when creating logic item, syntax error for logic comparator %s\n", logic);
+            error_exit("Fatal error when creating logic item, sytax error on comparator\n");
+        }
+    }
+    else
+    {
+        printf("Fatal error when creating logic item, syntax error for logic comparator %s\n", logic);
+        error_exit("Fatal error when creating logic item, sytax error on comparator\n");
+    }
+
+    LOGIC_ITEM* item = allocate_arena_memory(memory, sizeof(LOGIC_ITEM));
+
+    int column_len = strlen(column);
+
+    item->column_name = copy_arena_string(memory, column, column_len);
+    item->data = copy_arena_string(memory, data, data_size);
+    item->data_size = data_size;
+    item->logic_type = logic_type;
+    item->column = *((TABLE_ITEM**)get_array_list_data(table->columns, column_index));
+
+    char* dummy;
+    item->int_data = strtol(item->data, &dummy, 10);
+    item->float_data = strtof(item->data, &dummy);
+    item->char_data = data_size > 0 ? *(item->data) : ' ';
+
+    //Which orders satisfy the comparator, only != accepts values that cannot be ordered
+    memset(item->accept, 0, sizeof(item->accept));
+    item->accept[LESS_ORDER] = logic_type == 3 || logic_type == 4 || logic_type == 5;
+    item->accept[EQUAL_ORDER] = logic_type == 0 || logic_type == 2 || logic_type == 4;
+    item->accept[GREATER_ORDER] = logic_type == 1 || logic_type == 2 || logic_type == 5;
+    item->accept[UNORDERED] = logic_type == 5;
+
+    item->dictionary_matches = allocate_array_list(sizeof(char));
+    item->run_chunk = NULL;
+    item->selectivity = 1;
+    item->tested_count = 0;
+    item->passed_count = 0;
+
+    return item;
+}
+
+int is_true_on_int(LOGIC_ITEM* logic, long long table_data, long long logic_data)
+{
+    if(table_data < logic_data)
+    {
+        return logic->accept[LESS_ORDER];
+    }
+    if(table_data > logic_data)
+    {
+        return logic->accept[GREATER_ORDER];
+    }
+
+    return logic->accept[EQUAL_ORDER];
+}
+int is_true_on_float(LOGIC_ITEM* logic, float table_data)
+{
+    if(table_data < logic->float_data)
+    {
+        return logic->accept[LESS_ORDER];
+    }
+    if(table_data > logic->float_data)
+    {
+        return logic->accept[GREATER_ORDER];
+    }
+    if(table_data == logic->float_data)
+    {
+        return logic->accept[EQUAL_ORDER];
+    }
+
+    return logic->accept[UNORDERED];
+}
+
+//Packed values are compared against the constant shifted by the chunk base, run length chunks evaluate once per run
+int is_true_on_int_chunk(LOGIC_ITEM* logic, TABLE_ITEM* column, int row)
+{
+    int logic_data = logic->int_data;
+    COLUMN_CHUNK* chunk = get_column_chunk(column, row);
+    int offset = row & (ROW_GROUP_SIZE - 1);
+
+    if(chunk->encoding == PACKED_ENCODING)
+    {
+        return is_true_on_int(logic, get_packed_value(chunk, offset), (long long)logic_data - chunk->base);
+    }
+    else if(chunk->encoding == RUN_LENGTH_ENCODING)
+    {
+        if(logic->run_chunk == chunk)
+        {
+            RUN_ENTRY* run = (RUN_ENTRY*)get_array_list_data(chunk->runs, logic->run_index);
+            int run_start = logic->run_index == 0 ? 0 : ((RUN_ENTRY*)get_array_list_data(chunk->runs, logic->run_index - 1))->end;
+
+            if(offset >= run_start && offset < run->end)
+            {
+                return logic->run_result;
+            }
+        }
+
+        logic->run_chunk = chunk;
+        logic->run_index = find_chunk_run(chunk, offset);
+        logic->run_result = is_true_on_int(logic, ((RUN_ENTRY*)get_array_list_data(chunk->runs, logic->run_index))->value, logic_data);
+
+        return logic->run_result;
+    }
+
+    return is_true_on_int(logic, get_array_list_data_int(chunk->rows, offset), logic_data);
+}
+
+int is_true_on_char(LOGIC_ITEM* logic, char table_data)
+{
+    if(table_data < logic->char_data)
+    {
+        return logic->accept[LESS_ORDER];
+    }
+    if(table_data > logic->char_data)
+    {
+        return logic->accept[GREATER_ORDER];
+    }
+
+    return logic->accept[EQUAL_ORDER];
+}
+
+int is_true_on_string(LOGIC_ITEM* logic, char* table_data, int table_length)
+{
+    //Equality only needs the bytes compared when the lengths match
+    if(logic->logic_type == 0 || logic->logic_type == 5)
+    {
+        int is_equal = table_length == logic->data_size && memcmp(table_data, logic->data, table_length) == 0;
+        return is_equal == (logic->logic_type == 0);
+    }
+
+    int compare = strcmp(table_data, logic->data);
+    if(compare < 0)
+    {
+        return logic->accept[LESS_ORDER];
+    }
+    if(compare > 0)
+    {
+        return logic->accept[GREATER_ORDER];
+    }
+
+    return logic->accept[EQUAL_ORDER];
+}
+
+//The predicate is evaluated once per distinct value, rows then only look up the result of their code
+int is_true_on_dictionary(LOGIC_ITEM* logic, TABLE_ITEM* column, int row)
+{
+    int code = get_column_code(column, row);
+
+    while (logic->dictionary_matches->count <= code)
+    {
+        STRING_ENTRY* entry = (STRING_ENTRY*)get_array_list_data(column->dictionary->values, logic->dictionary_matches->count);
+        char* value = column->dictionary->heap->data + entry->offset;
+
+        if(column->type == CHAR_TYPE)
+        {
+            add_array_list_char(logic->dictionary_matches, is_true_on_char(logic, *value));
+        }
+        else
+        {
+            add_array_list_char(logic->dictionary_matches, is_true_on_string(logic, value, entry->length));
+        }
+    }
+
+    return get_array_list_data_char(logic->dictionary_matches, code);
+}
+
+int is_true_on_logic(LOGIC_ITEM* logic, int index)
+{
+    TABLE_ITEM* table_item = logic->column;
+
+    if(table_item->type == INT_TYPE)
+    {
+        return is_true_on_int_chunk(logic, table_item, index);
+    }
+    else if(table_item->type == FLOAT_TYPE)
+    {
+        return is_true_on_float(logic, get_column_float(table_item, index));
+    }
+    else if(table_item->dictionary != NULL)
+    {
+        return is_true_on_dictionary(logic, table_item, index);
+    }
+    else if(table_item->type == CHAR_TYPE)
+    {
+        return is_true_on_char(logic, get_column_char(table_item, index));
+    }
+    else if(table_item->type == VARCHAR_TYPE)
+    {
+        return is_true_on_string(logic, get_column_string(table_item, index), get_column_string_length(table_item, index));
+    }
+
+    return 1;
+}
+
+//Halving both counts keeps the hit rate weighted towards the recent row groups
+void record_logic_hits(LOGIC_ITEM* logic, int tested, int passed)
+{
+    logic->tested_count += tested;
+    logic->passed_count += passed;
+    if(logic->tested_count > LOGIC_SAMPLE_LIMIT)
+    {
+        logic->tested_count /= 2;
+        logic->passed_count /= 2;
+    }
+}
+//Relative cost of testing one row, fixed size types run through the block kernels and strings pay for strcmp
+float get_logic_cost(LOGIC_ITEM* logic)
+{
+    TABLE_ITEM* column = logic->column;
+
+    if(column->dictionary != NULL)
+    {
+        return 2;
+    }
+    if(column->type == INT_TYPE || column->type == FLOAT_TYPE || column->type == CHAR_TYPE)
+    {
+        return 1;
+    }
+
+    return 4 + column->data_size / 16.0f;
+}
+//Cheap conditions that reject most rows rank lowest and run first
+float get_logic_rank(LOGIC_ITEM* logic)
+{
+    float selectivity = logic->selectivity;
+    if(logic->tested_count >= LOGIC_SAMPLE_SIZE)
+    {
+        selectivity = (float)logic->passed_count / logic->tested_count;
+    }
+
+    float rejected = 1 - selectivity;
+    return get_logic_cost(logic) / (rejected < 0.01f ? 0.01f : rejected);
+}
+//Conditions are ANDed, so any order gives the same rows
+void order_logics(linked_list* logic_list)
+{
+    for(int i = 1; i < logic_list->count; i++)
+    {
+        LOGIC_ITEM* logic_item = *((LOGIC_ITEM**)get_linked_list_data(logic_list, i));
+        float rank = get_logic_rank(logic_item);
+
+        int j = i - 1;
+        for(; j >= 0; j--)
+        {
+            LOGIC_ITEM* previous = *((LOGIC_ITEM**)get_linked_list_data(logic_list, j));
+            if(get_logic_rank(previous) <= rank)
+            {
+                break;
+            }
+            set_linked_list_value_at(logic_list, j + 1, &previous);
+        }
+        set_linked_list_value_at(logic_list, j + 1, &logic_item);
+    }
+}
+int is_true_on_logics(linked_list* logic_list, int index)
+{
+    int is_true = 1;
+
+    for(int i = 0; i < logic_list->count; i++)
+    {
+        LOGIC_ITEM* logic_item = *((LOGIC_ITEM**)get_linked_list_data(logic_list, i));
+        int is_logic_true = is_true_on_logic(logic_item, index);
+
+        record_logic_hits(logic_item, 1, is_logic_true);
+        if(!is_logic_true)
+        {
+            is_true = 0;
+            break;
+        }
+    }
+    
+    return is_true;
+}
+
+int compare_row_address(const void* left, const void* right)
+{
+    return *((int*)left) - *((int*)right);
+}
+//Constant of a condition in the layout of its column's ordered index keys
+void* get_logic_key(LOGIC_ITEM* logic)
+{
+    if(logic->column->type == INT_TYPE)
+    {
+        return &logic->int_data;
+    }
+    else if(logic->column->type == FLOAT_TYPE)
+    {
+        return &logic->float_data;
+    }
+    else if(logic->column->type == CHAR_TYPE)
+    {
+        return &logic->char_data;
+    }
+
+    return logic->data;
+}
+//Walks the index range bounded by every condition on the column, sorted back into table order afterwards.
+//Conditions stay monotonic along the index, so the first key above one of them ends the range
+void collect_ordered_index_rows(linked_list* logic_list, TABLE_ITEM* column, array_list* rows)
+{
+    btree* index = column->ordered_index;
+    LOGIC_ITEM* lower_logic = NULL;
+
+    for(int i = 0; i < logic_list->count; i++)
+    {
+        LOGIC_ITEM* logic_item = *((LOGIC_ITEM**)get_linked_list_data(logic_list, i));
+        if(logic_item->column != column || logic_item->logic_type == 5)
+        {
+            continue;
+        }
+        if(column->type == FLOAT_TYPE && logic_item->float_data != logic_item->float_data)
+        {
+            return;
+        }
+        if(!logic_item->accept[LESS_ORDER] && (lower_logic == NULL || index->compare(get_logic_key(logic_item), get_logic_key(lower_logic)) > 0))
+        {
+            lower_logic = logic_item;
+        }
+    }
+
+    btree_iterator iterator = lower_logic != NULL ? get_btree_lower_bound(index, get_logic_key(lower_logic)) : get_btree_first(index);
+    for(; !is_btree_iterator_end(&iterator); next_btree_iterator(&iterator))
+    {
+        void* key = get_btree_iterator_key(&iterator);
+        int is_accepted = 1;
+
+        for(int i = 0; i < logic_list->count; i++)
+        {
+            LOGIC_ITEM* logic_item = *((LOGIC_ITEM**)get_linked_list_data(logic_list, i));
+            if(logic_item->column != column || logic_item->logic_type == 5)
+            {
+                continue;
+            }
+
+            int compare = index->compare(key, get_logic_key(logic_item));
+            enum LOGIC_ORDER order = compare < 0 ? LESS_ORDER : (compare > 0 ? GREATER_ORDER : EQUAL_ORDER);
+            if(!logic_item->accept[order])
+            {
+                if(order == GREATER_ORDER)
+                {
+                    goto sort;
+                }
+                is_accepted = 0;
+            }
+        }
+
+        if(is_accepted)
+        {
+            add_array_list_int(rows, get_btree_iterator_value(&iterator));
+        }
+    }
+
+    sort:
+    if(rows->count > 1)
+    {
+        qsort(rows->data, rows->count, sizeof(int), compare_row_address);
+    }
+}
+//Whether any value inside the chunk zone could satisfy the condition
+int is_zone_possible(LOGIC_ITEM* logic, COLUMN_CHUNK* chunk)
+{
+    if(chunk->has_unordered && logic->accept[UNORDERED])
+    {
+        return 1;
+    }
+    if(chunk->zone_count == 0)
+    {
+        return 0;
+    }
+    if(logic->column->type == FLOAT_TYPE && logic->float_data != logic->float_data)
+    {
+        return logic->accept[UNORDERED];
+    }
+
+    btree_compare compare = get_column_key_compare(logic->column);
+    int min_compare = compare(chunk->zone_min, get_logic_key(logic));
+    int max_compare = compare(chunk->zone_max, get_logic_key(logic));
+
+    return (logic->accept[LESS_ORDER] && min_compare < 0) || (logic->accept[GREATER_ORDER] && max_compare > 0) || (logic->accept[EQUAL_ORDER] && min_compare <= 0 && max_compare >= 0);
+}
+//Starting guess before any rows were tested, by comparator and dictionary size,
+//scaled by the share of row groups whose zone maps allow a match
+void estimate_logic_selectivity(LOGIC_ITEM* logic)
+{
+    TABLE_ITEM* column = logic->column;
+    float selectivity = logic->logic_type == 0 ? 0.1f : logic->logic_type == 5 ? 0.9f : 0.33f;
+
+    if(column->dictionary != NULL && column->dictionary->values->count > 0 && (logic->logic_type == 0 || logic->logic_type == 5))
+    {
+        float share = 1.0f / column->dictionary->values->count;
+        selectivity = logic->logic_type == 0 ? share : 1 - share;
+    }
+
+    int possible = 0;
+    for(int i = 0; i < column->chunks->count; i++)
+    {
+        possible += is_zone_possible(logic, *((COLUMN_CHUNK**)get_array_list_data(column->chunks, i)));
+    }
+    if(column->chunks->count > 0)
+    {
+        selectivity *= (float)possible / column->chunks->count;
+    }
+
+    logic->selectivity = selectivity;
+    logic->tested_count = 0;
+    logic->passed_count = 0;
+}
+int is_row_group_possible(ROW_SCAN* scan, int group)
+{
+    for(int i = 0; i < scan->logics->count; i++)
+    {
+        LOGIC_ITEM* logic_item = *((LOGIC_ITEM**)get_linked_list_data(scan->logics, i));
+        if(!is_zone_possible(logic_item, *((COLUMN_CHUNK**)get_array_list_data(logic_item->column->chunks, group))))
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+//Batch filters keep the offsets of the selection whose value the condition accepts, in order, and return how many are left.
+//Offsets are always written and only kept by advancing, so the loops do not branch on the outcome
+int filter_int_rows(LOGIC_ITEM* logic, int* values, int* selection, int count)
+{
+    int constant = logic->int_data;
+    int kept = 0;
+
+    for(int i = 0; i < count; i++)
+    {
+        int offset = *(selection + i);
+        int value = *(values + offset);
+
+        *(selection + kept) = offset;
+        kept += logic->accept[(value > constant) - (value < constant) + EQUAL_ORDER];
+    }
+
+    return kept;
+}
+int filter_float_rows(LOGIC_ITEM* logic, float* values, int* selection, int count)
+{
+    float constant = logic->float_data;
+    int kept = 0;
+
+    for(int i = 0; i < count; i++)
+    {
+        int offset = *(selection + i);
+        float value = *(values + offset);
+
+        *(selection + kept) = offset;
+        kept += logic->accept[(value == constant) + 2 * (value > constant) + 3 * !(value <= constant || value > constant)];
+    }
+
+    return kept;
+}
+int filter_char_rows(LOGIC_ITEM* logic, char* values, int* selection, int count)
+{
+    char constant = logic->char_data;
+    int kept = 0;
+
+    for(int i = 0; i < count; i++)
+    {
+        int offset = *(selection + i);
+        char value = *(values + offset);
+
+        *(selection + kept) = offset;
+        kept += logic->accept[(value > constant) - (value < constant) + EQUAL_ORDER];
+    }
+
+    return kept;
+}
+//Run length chunks decide once per run, the selection is walked alongside the runs since both are ordered
+int filter_run_rows(LOGIC_ITEM* logic, COLUMN_CHUNK* chunk, int* selection, int count)
+{
+    int kept = 0;
+    int run_index = 0;
+    RUN_ENTRY* run = (RUN_ENTRY*)get_array_list_data(chunk->runs, 0);
+    int run_result = is_true_on_int(logic, run->value, logic->int_data);
+
+    for(int i = 0; i < count; i++)
+    {
+        int offset = *(selection + i);
+        while (offset >= run->end)
+        {
+            run_index++;
+            run = (RUN_ENTRY*)get_array_list_data(chunk->runs, run_index);
+            run_result = is_true_on_int(logic, run->value, logic->int_data);
+        }
+
+        *(selection + kept) = offset;
+        kept += run_result;
+    }
+
+    return kept;
+}
+//Every code of the dictionary is decided before the pass, rows then only index the results
+int filter_dictionary_rows(LOGIC_ITEM* logic, COLUMN_CHUNK* chunk, int* selection, int count)
+{
+    COLUMN_DICTIONARY* dictionary = logic->column->dictionary;
+    while (logic->dictionary_matches->count < dictionary->values->count)
+    {
+        STRING_ENTRY* entry = (STRING_ENTRY*)get_array_list_data(dictionary->values, logic->dictionary_matches->count);
+        char* value = dictionary->heap->data + entry->offset;
+
+        if(logic->column->type == CHAR_TYPE)
+        {
+            add_array_list_char(logic->dictionary_matches, is_true_on_char(logic, *value));
+        }
+        else
+        {
+            add_array_list_char(logic->dictionary_matches, is_true_on_string(logic, value, entry->length));
+        }
+    }
+
+    char* matches = logic->dictionary_matches->data;
+    int kept = 0;
+
+    for(int i = 0; i < count; i++)
+    {
+        int offset = *(selection + i);
+        int code = logic->column->row_size == sizeof(unsigned char) ? *((unsigned char*)chunk->rows->data + offset) : *((unsigned short*)chunk->rows->data + offset);
+
+        *(selection + kept) = offset;
+        kept += *(matches + code);
+    }
+
+    return kept;
+}
+int filter_logic_rows(ROW_SCAN* scan, LOGIC_ITEM* logic, int count)
+{
+    TABLE_ITEM* column = logic->column;
+    COLUMN_CHUNK* chunk = *((COLUMN_CHUNK**)get_array_list_data(column->chunks, scan->group));
+
+    if(column->type == INT_TYPE)
+    {
+        if(chunk->encoding == RUN_LENGTH_ENCODING)
+        {
+            return filter_run_rows(logic, chunk, scan->selection, count);
+        }
+        if(chunk->encoding == PACKED_ENCODING)
+        {
+            //Only the selected values are unpacked, at their own offsets
+            for(int i = 0; i < count; i++)
+            {
+                int offset = *(scan->selection + i);
+                *(scan->values + offset) = chunk->base + get_packed_value(chunk, offset);
+            }
+            return filter_int_rows(logic, scan->values, scan->selection, count);
+        }
+        return filter_int_rows(logic, (int*)chunk->rows->data, scan->selection, count);
+    }
+    else if(column->type == FLOAT_TYPE)
+    {
+        return filter_float_rows(logic, (float*)chunk->rows->data, scan->selection, count);
+    }
+    else if(column->dictionary != NULL)
+    {
+        return filter_dictionary_rows(logic, chunk, scan->selection, count);
+    }
+    else if(column->type == CHAR_TYPE)
+    {
+        return filter_char_rows(logic, chunk->rows->data, scan->selection, count);
+    }
+
+    int kept = 0;
+    for(int i = 0; i < count; i++)
+    {
+        int offset = *(scan->selection + i);
+
+        *(scan->selection + kept) = offset;
+        kept += is_true_on_logic(logic, (scan->group << ROW_GROUP_SHIFT) + offset);
+    }
+
+    return kept;
+}
+//Compares every value of a plainly stored INT, FLOAT or CHAR chunk into the match words, returns 0 for other chunks
+int compare_logic_block(ROW_SCAN* scan, LOGIC_ITEM* logic, int row_count)
+{
+    TABLE_ITEM* column = logic->column;
+    COLUMN_CHUNK* chunk = *((COLUMN_CHUNK**)get_array_list_data(column->chunks, scan->group));
+
+    if(column->type == INT_TYPE && chunk->encoding != RUN_LENGTH_ENCODING)
+    {
+        //Rows of compressed chunks are gone, packed values are unpacked first
+        int* values = scan->values;
+        if(chunk->encoding == PACKED_ENCODING)
+        {
+            for(int offset = 0; offset < row_count; offset++)
+            {
+                *(scan->values + offset) = chunk->base + get_packed_value(chunk, offset);
+            }
+        }
+        else
+        {
+            values = (int*)chunk->rows->data;
+        }
+        compare_int_block(values, row_count, logic->int_data, logic->logic_type, scan->match_words);
+    }
+    else if(column->type == FLOAT_TYPE)
+    {
+        compare_float_block((float*)chunk->rows->data, row_count, logic->float_data, logic->logic_type, scan->match_words);
+    }
+    else if(column->type == CHAR_TYPE && column->dictionary == NULL)
+    {
+        compare_char_block(chunk->rows->data, row_count, logic->char_data, logic->logic_type, scan->match_words);
+    }
+    else
+    {
+        return 0;
+    }
+
+    return 1;
+}
+//Starts from the live rows of the row group as a bitmask and ANDs in the block compare of every leading condition that has one.
+//The bits left become the selection the remaining conditions narrow down row by row
+int select_row_group(ROW_SCAN* scan, int group)
+{
+    ROW_GROUP* row_group = get_row_group(scan->table, group);
+    int word_count = (row_group->row_count + 63) / 64;
+
+    scan->group = group;
+    for(int i = 0; i < word_count; i++)
+    {
+        *(scan->selection_words + i) = ~row_group->deleted[i];
+    }
+    if(row_group->row_count & 63)
+    {
+        *(scan->selection_words + word_count - 1) &= (1ull << (row_group->row_count & 63)) - 1;
+    }
+
+    int selected = row_group->live_count;
+    int logic_index = 0;
+    for(; logic_index < scan->logics->count; logic_index++)
+    {
+        LOGIC_ITEM* logic_item = *((LOGIC_ITEM**)get_linked_list_data(scan->logics, logic_index));
+        if(!compare_logic_block(scan, logic_item, row_group->row_count))
+        {
+            break;
+        }
+
+        int tested = selected;
+        selected = 0;
+        for(int i = 0; i < word_count; i++)
+        {
+            *(scan->selection_words + i) &= *(scan->match_words + i);
+            selected += count_word_bits(*(scan->selection_words + i));
+        }
+        record_logic_hits(logic_item, tested, selected);
+        if(selected == 0)
+        {
+            return 0;
+        }
+    }
+
+    int count = 0;
+    for(int i = 0; i < word_count; i++)
+    {
+        unsigned long long word = *(scan->selection_words + i);
+        for(int bit = 0; word != 0; bit++, word >>= 1)
+        {
+            *(scan->selection + count) = (i << 6) + bit;
+            count += (int)(word & 1);
+        }
+    }
+
+    for(; logic_index < scan->logics->count && count > 0; logic_index++)
+    {
+        LOGIC_ITEM* logic_item = *((LOGIC_ITEM**)get_linked_list_data(scan->logics, logic_index));
+        int tested = count;
+
+        count = filter_logic_rows(scan, logic_item, count);
+        record_logic_hits(logic_item, tested, count);
+    }
+
+    return count;
+}
+//First selected row from the given row group on, skipping row groups the zone maps rule out
+int advance_row_scan(ROW_SCAN* scan, int group)
+{
+    for(; group < scan->table->row_groups->count; group++)
+    {
+        if(!is_row_group_possible(scan, group))
+        {
+            continue;
+        }
+
+        //Hit rates seen so far decide the order for the next row group
+        order_logics(scan->logics);
+        scan->selection_count = select_row_group(scan, group);
+        if(scan->selection_count > 0)
+        {
+            scan->position = 0;
+            return (group << ROW_GROUP_SHIFT) + *(scan->selection);
+        }
+    }
+
+    return -1;
+}
+//Index results are only candidates for the conditions the index could not answer
+int filter_indexed_rows(ROW_SCAN* scan)
+{
+    int kept = 0;
+    for(int i = 0; i < scan->rows->count; i++)
+    {
+        int row = get_array_list_data_int(scan->rows, i);
+        if(is_true_on_logics(scan->logics, row))
+        {
+            set_array_list_value_int_at(scan->rows, kept++, row);
+        }
+    }
+    scan->rows->count = kept;
+
+    return kept > 0 ? get_array_list_data_int(scan->rows, 0) : -1;
+}
+ROW_SCAN* allocate_row_scan()
+{
+    ROW_SCAN* scan = heapallocate(sizeof(ROW_SCAN));
+    scan->table = NULL;
+    scan->logics = NULL;
+    scan->is_indexed = 0;
+    scan->rows = allocate_array_list(sizeof(int));
+    scan->position = 0;
+    scan->group = 0;
+    scan->selection = heapallocate(ROW_GROUP_SIZE * sizeof(int));
+    scan->selection_count = 0;
+    scan->selection_words = heapallocate(ROW_GROUP_SIZE / 64 * sizeof(unsigned long long));
+    scan->match_words = heapallocate(ROW_GROUP_SIZE / 64 * sizeof(unsigned long long));
+    scan->values = heapallocate(ROW_GROUP_SIZE * sizeof(int));
+    scan->matches = allocate_bitmap();
+    scan->condition = allocate_bitmap();
+
+    return scan;
+}
+//Unions the bitmaps of every distinct value the condition accepts
+void collect_bitmap_condition(LOGIC_ITEM* logic, bitmap* condition)
+{
+    BITMAP_INDEX* index = logic->column->bitmap_index;
+    btree_compare compare = get_column_key_compare(logic->column);
+
+    clear_bitmap(condition);
+    for(int i = 0; i < index->keys->count; i++)
+    {
+        int key_compare = compare(get_array_list_data(index->keys, i), get_logic_key(logic));
+        enum LOGIC_ORDER order = key_compare < 0 ? LESS_ORDER : (key_compare > 0 ? GREATER_ORDER : EQUAL_ORDER);
+
+        if(logic->accept[order])
+        {
+            or_bitmap(condition, get_bitmap_index_rows(index, i));
+        }
+    }
+}
+//Conditions on bitmap indexed columns are combined with a bitwise AND first. Otherwise picks a column whose
+//ordered index can answer the conditions, equality first, != still needs every row
+int begin_row_scan(ROW_SCAN* scan, TABLE_DECLARATION* table, linked_list* logic_list)
+{
+    scan->table = table;
+    scan->logics = logic_list;
+    scan->is_indexed = 0;
+    scan->position = 0;
+    clear_array_list(scan->rows);
+
+    for(int i = 0; i < logic_list->count; i++)
+    {
+        estimate_logic_selectivity(*((LOGIC_ITEM**)get_linked_list_data(logic_list, i)));
+    }
+    order_logics(logic_list);
+
+    int bitmap_count = 0;
+    for(int i = 0; i < logic_list->count; i++)
+    {
+        LOGIC_ITEM* logic_item = *((LOGIC_ITEM**)get_linked_list_data(logic_list, i));
+        if(logic_item->column->bitmap_index == NULL)
+        {
+            continue;
+        }
+
+        if(bitmap_count == 0)
+        {
+            collect_bitmap_condition(logic_item, scan->matches);
+        }
+        else
+        {
+            collect_bitmap_condition(logic_item, scan->condition);
+            and_bitmap(scan->matches, scan->condition);
+        }
+        bitmap_count++;
+    }
+
+    if(bitmap_count > 0)
+    {
+        get_bitmap_values(scan->matches, scan->rows);
+        scan->is_indexed = 1;
+
+        return filter_indexed_rows(scan);
+    }
+
+    LOGIC_ITEM* indexed_logic = NULL;
+    for(int i = 0; i < logic_list->count; i++)
+    {
+        LOGIC_ITEM* logic_item = *((LOGIC_ITEM**)get_linked_list_data(logic_list, i));
+        if(logic_item->column->ordered_index == NULL || logic_item->logic_type == 5)
+        {
+            continue;
+        }
+        if(indexed_logic == NULL || (logic_item->logic_type == 0 && indexed_logic->logic_type != 0))
+        {
+            indexed_logic = logic_item;
+        }
+    }
+
+    if(indexed_logic == NULL)
+    {
+        return advance_row_scan(scan, 0);
+    }
+
+    collect_ordered_index_rows(logic_list, indexed_logic->column, scan->rows);
+    scan->is_indexed = 1;
+
+    return filter_indexed_rows(scan);
+}
+int next_row_scan(ROW_SCAN* scan)
+{
+    scan->position++;
+    if(scan->is_indexed)
+    {
+        return scan->position < scan->rows->count ? get_array_list_data_int(scan->rows, scan->position) : -1;
+    }
+
+    if(scan->position < scan->selection_count)
+    {
+        return (scan->group << ROW_GROUP_SHIFT) + *(scan->selection + scan->position);
+    }
+
+    return advance_row_scan(scan, scan->group + 1);
+}
+
+enum RESULT_TYPE get_column_result_type(TABLE_ITEM* table_item)
+{
+    if(table_item->type == INT_TYPE)
+    {
+        return RESULT_INT;
+    }
+    else if(table_item->type == FLOAT_TYPE)
+    {
+        return RESULT_FLOAT;
+    }
+    else if(table_item->type == CHAR_TYPE)
+    {
+        return RESULT_CHAR;
+    }
+
+    return RESULT_STRING;
+}
+void write_column_value(result_sink* sink, TABLE_ITEM* table_item, int row)
+{
+    if(table_item->type == INT_TYPE)
+    {
+        write_result_cell_int(sink, get_column_int(table_item, row));
+    }
+    else if(table_item->type == FLOAT_TYPE)
+    {
+        write_result_cell_float(sink, get_column_float(table_item, row));
+    }
+    else if(table_item->type == CHAR_TYPE)
+    {
+        write_result_cell_char(sink, get_column_char(table_item, row));
+    }
+    else if(table_item->type == VARCHAR_TYPE)
+    {
+        write_result_cell_string(sink, get_column_string(table_item, row), get_column_string_length(table_item, row));
+    }
+}
+//Title line of a TEXT DISPLAY, joined is NULL unless two tables are joined. Other formats have no title
+void write_display_title(result_sink* sink, TABLE_DECLARATION* table, TABLE_DECLARATION* joined)
+{
+    result_writer* writer = sink->writer;
+    if(sink->format != TEXT_FORMAT)
+    {
+        return;
+    }
+
+    write_result_text(writer, "=======================");
+    write_result_text(writer, table->name);
+    if(joined != NULL)
+    {
+        write_result_text(writer, " JOIN ");
+        write_result_text(writer, joined->name);
+    }
+    write_result_text(writer, "=======================\n");
+}
+
+//Orders two rows by a column the same way the ordered indexes do, NaN is never passed in
+int compare_column_rows(TABLE_ITEM* column, int left, int right)
+{
+    if(column->type == INT_TYPE)
+    {
+        int left_value = get_column_int(column, left);
+        int right_value = get_column_int(column, right);
+
+        return (left_value > right_value) - (left_value < right_value);
+    }
+    else if(column->type == FLOAT_TYPE)
+    {
+        float left_value = get_column_float(column, left);
+        float right_value = get_column_float(column, right);
+
+        return (left_value > right_value) - (left_value < right_value);
+    }
+    else if(column->type == CHAR_TYPE)
+    {
+        char left_value = get_column_char(column, left);
+        char right_value = get_column_char(column, right);
+
+        return (left_value > right_value) - (left_value < right_value);
+    }
+
+    return strcmp(get_column_string(column, left), get_column_string(column, right));
+}
+//Columns are bound once when the DISPLAY starts, rows only walk the handles
+void write_display_row(result_sink* sink, TABLE_ITEM** columns, int column_count, int row)
+{
+    for(int i = 0; i < column_count; i++)
+    {
+        write_column_value(sink, *(columns + i), row);
+    }
+    end_result_row(sink);
+}
+ROW_ORDER* allocate_row_order()
+{
+    ROW_ORDER* order = heapallocate(sizeof(ROW_ORDER));
+    order->column = NULL;
+    order->is_descending = 0;
+    order->limit = -1;
+    order->offset = 0;
+    order->rows = allocate_array_list(sizeof(int));
+
+    return order;
+}
+//End of the rows LIMIT lets through out of count
+int get_order_end(ROW_ORDER* order, int count)
+{
+    if(order->limit == -1 || (long long)order->offset + order->limit > count)
+    {
+        return count;
+    }
+
+    return order->offset + order->limit;
+}
+//NaN sorts after every number, rows that tie stay in table order
+int compare_order_rows(ROW_ORDER* order, int left, int right)
+{
+    TABLE_ITEM* column = order->column;
+    int compare = 0;
+
+    if(column->type == FLOAT_TYPE)
+    {
+        float left_value = get_column_float(column, left);
+        float right_value = get_column_float(column, right);
+        int left_nan = left_value != left_value;
+        int right_nan = right_value != right_value;
+
+        compare = left_nan || right_nan ? left_nan - right_nan : (left_value > right_value) - (left_value < right_value);
+    }
+    else
+    {
+        compare = compare_column_rows(column, left, right);
+    }
+
+    if(order->is_descending)
+    {
+        compare = -compare;
+    }
+
+    return compare != 0 ? compare : (left > right) - (left < right);
+}
+void sift_order_heap_up(ROW_ORDER* order, int* heap, int index)
+{
+    while (index > 0)
+    {
+        int parent = (index - 1) / 2;
+        if(compare_order_rows(order, *(heap + index), *(heap + parent)) <= 0)
+        {
+            return;
+        }
+
+        int row = *(heap + index);
+        *(heap + index) = *(heap + parent);
+        *(heap + parent) = row;
+        index = parent;
+    }
+}
+void sift_order_heap_down(ROW_ORDER* order, int* heap, int count, int index)
+{
+    while (1)
+    {
+        int largest = index;
+        int left = index * 2 + 1;
+        int right = left + 1;
+
+        if(left < count && compare_order_rows(order, *(heap + left), *(heap + largest)) > 0)
+        {
+            largest = left;
+        }
+        if(right < count && compare_order_rows(order, *(heap + right), *(heap + largest)) > 0)
+        {
+            largest = right;
+        }
+        if(largest == index)
+        {
+            return;
+        }
+
+        int row = *(heap + index);
+        *(heap + index) = *(heap + largest);
+        *(heap + largest) = row;
+        index = largest;
+    }
+}
+//With a LIMIT only the best offset + limit rows are kept, a row better than the worst kept one replaces it.
+//The heap is sorted in place at the end
+void collect_ordered_rows(ROW_ORDER* order, ROW_SCAN* scan, TABLE_DECLARATION* table, linked_list* logic_list)
+{
+    long long bound = order->limit == -1 ? -1 : (long long)order->offset + order->limit;
+
+    clear_array_list(order->rows);
+    for(int i = begin_row_scan(scan, table, logic_list); i != -1; i = next_row_scan(scan))
+    {
+        if(bound == -1 || order->rows->count < bound)
+        {
+            add_array_list_int(order->rows, i);
+            sift_order_heap_up(order, (int*)order->rows->data, order->rows->count - 1);
+        }
+        else if(order->rows->count > 0 && compare_order_rows(order, i, *((int*)order->rows->data)) < 0)
+        {
+            *((int*)order->rows->data) = i;
+            sift_order_heap_down(order, (int*)order->rows->data, order->rows->count, 0);
+        }
+    }
+
+    int* heap = (int*)order->rows->data;
+    for(int end = order->rows->count - 1; end > 0; end--)
+    {
+        int row = *heap;
+        *heap = *(heap + end);
+        *(heap + end) = row;
+        sift_order_heap_down(order, heap, end, 0);
+    }
+}
+void end_display_order(ROW_ORDER* order)
+{
+    order->column = NULL;
+    order->is_descending = 0;
+    order->limit = -1;
+    order->offset = 0;
+}
+
+HASH_JOIN* allocate_hash_join()
+{
+    HASH_JOIN* join = heapallocate(sizeof(HASH_JOIN));
+    join->left_table = NULL;
+    join->right_table = NULL;
+    join->left_column = NULL;
+    join->right_column = NULL;
+    join->left_logics = NULL;
+    join->right_logics = allocate_linked_list(sizeof(LOGIC_ITEM*));
+    join->columns = allocate_array_list(sizeof(JOIN_COLUMN));
+    join->left_rows = allocate_array_list(sizeof(int));
+    join->right_rows = allocate_array_list(sizeof(int));
+    join->buckets = allocate_hash_map(sizeof(int));
+    join->next = allocate_array_list(sizeof(int));
+    join->key = allocate_array_list(sizeof(char));
+    join->matches = allocate_array_list(sizeof(JOIN_ROW));
+
+    return join;
+}
+//Looks the column up on one side of the join, Table.Column only matches the side with that table name
+int find_join_column_on_side(HASH_JOIN* join, const char* name, int side, JOIN_COLUMN* result)
+{
+    TABLE_DECLARATION* table = side == 0 ? join->left_table : join->right_table;
+    const char* dot = strchr(name, '.');
+    const char* column_name = name;
+
+    if(dot != NULL)
+    {
+        int table_length = (int)(dot - name);
+        if((int)strlen(table->name) != table_length || strncmp(table->name, name, table_length) != 0)
+        {
+            return 0;
+        }
+        column_name = dot + 1;
+    }
+
+    int column_index = get_column_index(table, column_name);
+    if(column_index == -1)
+    {
+        return 0;
+    }
+
+    result->side = side;
+    result->column = *((TABLE_ITEM**)get_array_list_data(table->columns, column_index));
+    return 1;
+}
+//Columns are looked up on the left table first, Table.Column picks the side explicitly
+int find_join_column(HASH_JOIN* join, const char* name, JOIN_COLUMN* result)
+{
+    return find_join_column_on_side(join, name, 0, result) || find_join_column_on_side(join, name, 1, result);
+}
+//Puts the ON operands on opposite sides, a name found in both tables takes the side the other operand leaves free.
+//Returns 0 when a name is missing and -1 when both can only come from the same table
+int find_join_key_columns(HASH_JOIN* join, const char* first_name, const char* second_name, JOIN_COLUMN* first, JOIN_COLUMN* second)
+{
+    for(int side = 0; side < 2; side++)
+    {
+        if(find_join_column_on_side(join, first_name, side, first) && find_join_column_on_side(join, second_name, 1 - side, second))
+        {
+            return 1;
+        }
+    }
+
+    return find_join_column(join, first_name, first) && find_join_column(join, second_name, second) ? -1 : 0;
+}
+//DISPLAY columns FROM left JOIN right ON column = column, columns can be ALL
+void begin_display_join(HASH_JOIN* join, TABLE_CATALOG* tables, parsedata* tokens, linked_list* left_logics)
+{
+    int length = tokens->length;
+    if(strcmp(tokens->data[length - 8], FROM_COMMAND) != 0 || strcmp(tokens->data[length - 4], ON_COMMAND) != 0 || strcmp(tokens->data[length - 2], "=") != 0)
+    {
+        error_exit("Syntax error for JOIN command : DISPLAY\n");
+    }
+
+    for(int side = 0; side < 2; side++)
+    {
+        char* table_name = tokens->data[side == 0 ? length - 7 : length - 5];
+        int table_index = get_table_index(tables, table_name);
+        if(table_index == -1)
+        {
+            printf("Cannot find table : %s\n", table_name);
+            error_exit("Cannot find table for DISPLAY\n");
+        }
+
+        TABLE_DECLARATION* table = *((TABLE_DECLARATION**)get_array_list_data(tables->declarations, table_index));
+        if(side == 0)
+        {
+            join->left_table = table;
+        }
+        else
+        {
+            join->right_table = table;
+        }
+    }
+    if(join->left_table == join->right_table)
+    {
+        error_exit("Cannot JOIN a table with itself\n");
+    }
+
+    JOIN_COLUMN first;
+    JOIN_COLUMN second;
+    int is_found = find_join_key_columns(join, tokens->data[length - 3], tokens->data[length - 1], &first, &second);
+    if(is_found == 0)
+    {
+        printf("Cannot find join columns : %s = %s\n", tokens->data[length - 3], tokens->data[length - 1]);
+        error_exit("Cannot find column for JOIN\n");
+    }
+    if(is_found == -1)
+    {
+        error_exit("JOIN columns have to come from both tables\n");
+    }
+    if(first.column->type != second.column->type)
+    {
+        error_exit("JOIN columns have to be of the same type\n");
+    }
+    join->left_column = first.side == 0 ? first.column : second.column;
+    join->right_column = first.side == 0 ? second.column : first.column;
+    join->left_logics = left_logics;
+
+    clear_array_list(join->columns);
+    if(length == 10 && strcmp(tokens->data[1], ALL_COMMAND) == 0)
+    {
+        for(int side = 0; side < 2; side++)
+        {
+            TABLE_DECLARATION* table = side == 0 ? join->left_table : join->right_table;
+            for(int i = 0; i < table->columns->count; i++)
+            {
+                JOIN_COLUMN join_column = {side, *((TABLE_ITEM**)get_array_list_data(table->columns, i))};
+                add_array_list_value(join->columns, &join_column);
+            }
+        }
+        return;
+    }
+
+    for(int i = 1; i < length - 8; i++)
+    {
+        JOIN_COLUMN join_column;
+        if(!find_join_column(join, tokens->data[i], &join_column))
+        {
+            printf("Cannot find column : %s\n", tokens->data[i]);
+            error_exit("Cannot find column for DISPLAY\n");
+        }
+        add_array_list_value(join->columns, &join_column);
+    }
+}
+//Conditions go to the table their column belongs to and filter that side before the join
+void add_join_logic(HASH_JOIN* join, arena* memory, parsedata* tokens)
+{
+    JOIN_COLUMN join_column;
+    if(!find_join_column(join, tokens->data[1], &join_column))
+    {
+        printf("Cannot find column : %s\n", tokens->data[1]);
+        error_exit("Cannot find column for WHERE on DISPLAY\n");
+    }
+
+    TABLE_DECLARATION* table = join_column.side == 0 ? join->left_table : join->right_table;
+    LOGIC_ITEM* logic_item = create_logic_item(memory, table, join_column.column->name, tokens->data[2], tokens->size[2], tokens->data[3], tokens->size[3]);
+    add_linked_list_value(join_column.side == 0 ? join->left_logics : join->right_logics, &logic_item);
+}
+void collect_scan_rows(ROW_SCAN* scan, TABLE_DECLARATION* table, linked_list* logic_list, array_list* rows)
+{
+    clear_array_list(rows);
+    for(int i = begin_row_scan(scan, table, logic_list); i != -1; i = next_row_scan(scan))
+    {
+        add_array_list_int(rows, i);
+    }
+}
+//Matches come out in the order of the probing side, build rows are chained in reverse so each chain is in table order.
+//Values that have no key, like NaN, never match
+int run_hash_join(HASH_JOIN* join, ROW_SCAN* scan)
+{
+    collect_scan_rows(scan, join->left_table, join->left_logics, join->left_rows);
+    collect_scan_rows(scan, join->right_table, join->right_logics, join->right_rows);
+    clear_hash_map(join->buckets);
+    clear_array_list(join->matches);
+
+    int is_left_build = join->left_rows->count <= join->right_rows->count;
+    array_list* build_rows = is_left_build ? join->left_rows : join->right_rows;
+    array_list* probe_rows = is_left_build ? join->right_rows : join->left_rows;
+    TABLE_ITEM* build_column = is_left_build ? join->left_column : join->right_column;
+    TABLE_ITEM* probe_column = is_left_build ? join->right_column : join->left_column;
+
+    reserve_array_list(join->next, build_rows->count);
+    join->next->count = build_rows->count;
+    int* next = (int*)join->next->data;
+
+    for(int i = build_rows->count - 1; i >= 0; i--)
+    {
+        clear_array_list(join->key);
+        if(!add_key_row(join->key, build_column, get_array_list_data_int(build_rows, i)))
+        {
+            continue;
+        }
+
+        int* head = (int*)get_hash_map_data(join->buckets, join->key->data, join->key->count);
+        *(next + i) = head != NULL ? *head : -1;
+        put_hash_map_value(join->buckets, join->key->data, join->key->count, &i);
+    }
+
+    for(int i = 0; i < probe_rows->count; i++)
+    {
+        int probe_row = get_array_list_data_int(probe_rows, i);
+
+        clear_array_list(join->key);
+        if(!add_key_row(join->key, probe_column, probe_row))
+        {
+            continue;
+        }
+
+        int* head = (int*)get_hash_map_data(join->buckets, join->key->data, join->key->count);
+        for(int position = head != NULL ? *head : -1; position != -1; position = *(next + position))
+        {
+            int build_row = get_array_list_data_int(build_rows, position);
+            JOIN_ROW match = {is_left_build ? build_row : probe_row, is_left_build ? probe_row : build_row};
+
+            add_array_list_value(join->matches, &match);
+        }
+    }
+
+    return join->matches->count;
+}
+void display_join_rows(HASH_JOIN* join, ROW_SCAN* scan, ROW_ORDER* order, result_sink* sink)
+{
+    write_display_title(sink, join->left_table, join->right_table);
+    for(int i = 0; i < join->columns->count; i++)
+    {
+        JOIN_COLUMN* join_column = (JOIN_COLUMN*)get_array_list_data(join->columns, i);
+        TABLE_DECLARATION* table = join_column->side == 0 ? join->left_table : join->right_table;
+
+        add_result_column(sink, table->name, join_column->column->name, get_column_result_type(join_column->column));
+    }
+    begin_result_rows(sink);
+
+    run_hash_join(join, scan);
+    for(int i = order->offset; i < get_order_end(order, join->matches->count); i++)
+    {
+        JOIN_ROW* match = (JOIN_ROW*)get_array_list_data(join->matches, i);
+        for(int j = 0; j < join->columns->count; j++)
+        {
+            JOIN_COLUMN* join_column = (JOIN_COLUMN*)get_array_list_data(join->columns, j);
+            write_column_value(sink, join_column->column, join_column->side == 0 ? match->left : match->right);
+        }
+        end_result_row(sink);
+    }
+}
+void end_display_join(HASH_JOIN* join)
+{
+    for(int i = 0; i < join->right_logics->count; i++)
+    {
+        free_logic(*((LOGIC_ITEM**)get_linked_list_data(join->right_logics, i)));
+    }
+    clear_linked_list(join->right_logics);
+    clear_hash_map(join->buckets);
+    join->left_table = NULL;
+    join->right_table = NULL;
+}
+
+HASH_AGGREGATE* allocate_hash_aggregate()
+{
+    HASH_AGGREGATE* aggregate = heapallocate(sizeof(HASH_AGGREGATE));
+    aggregate->is_active = 0;
+    aggregate->items = allocate_array_list(sizeof(AGGREGATE_ITEM));
+    aggregate->group_columns = allocate_array_list(sizeof(TABLE_ITEM*));
+    aggregate->groups = allocate_hash_map(sizeof(int));
+    aggregate->group_rows = allocate_array_list(sizeof(int));
+    aggregate->values = allocate_array_list(sizeof(AGGREGATE_VALUE));
+    aggregate->key = allocate_array_list(sizeof(char));
+
+    return aggregate;
+}
+//Output column of an aggregating DISPLAY, FUNCTION(column) or a plain column that has to be in GROUP BY
+void add_aggregate_item(HASH_AGGREGATE* aggregate, arena* memory, TABLE_DECLARATION* table, char* token)
+{
+    int length = strlen(token);
+    char* open = strchr(token, '(');
+
+    AGGREGATE_ITEM item;
+    item.type = GROUP_AGGREGATE;
+    item.column = NULL;
+    item.label = copy_arena_string(memory, token, length);
+
+    char* column_name = token;
+    if(open != NULL)
+    {
+        if(*(token + length - 1) != ')')
+        {
+            printf("Syntax error for aggregate : %s\n", item.label);
+            error_exit("Syntax error for aggregate on DISPLAY\n");
+        }
+        *open = '\0';
+        *(token + length - 1) = '\0';
+        column_name = open + 1;
+
+        if(strcmp(token, COUNT_COMMAND) == 0)
+        {
+            item.type = COUNT_AGGREGATE;
+        }
+        else if(strcmp(token, SUM_COMMAND) == 0)
+        {
+            item.type = SUM_AGGREGATE;
+        }
+        else if(strcmp(token, AVG_COMMAND) == 0)
+        {
+            item.type = AVG_AGGREGATE;
+        }
+        else if(strcmp(token, MIN_COMMAND) == 0)
+        {
+            item.type = MIN_AGGREGATE;
+        }
+        else if(strcmp(token, MAX_COMMAND) == 0)
+        {
+            item.type = MAX_AGGREGATE;
+        }
+        else
+        {
+            printf("Unknown aggregate : %s\n", item.label);
+            error_exit("Unknown aggregate on DISPLAY\n");
+        }
+
+        if(item.type == COUNT_AGGREGATE && strcmp(column_name, "*") == 0)
+        {
+            add_array_list_value(aggregate->items, &item);
+            return;
+        }
+    }
+
+    int column_index = get_column_index(table, column_name);
+    if(column_index == -1)
+    {
+        printf("Cannot find column : %s\n", column_name);
+        error_exit("Cannot find column for DISPLAY\n");
+    }
+
+    item.column = *((TABLE_ITEM**)get_array_list_data(table->columns, column_index));
+    if((item.type == SUM_AGGREGATE || item.type == AVG_AGGREGATE) && item.column->type != INT_TYPE && item.column->type != FLOAT_TYPE)
+    {
+        printf("Cannot sum column : %s\n", column_name);
+        error_exit("SUM and AVG need an INT or FLOAT column\n");
+    }
+
+    add_array_list_value(aggregate->items, &item);
+}
+void add_group_column(HASH_AGGREGATE* aggregate, TABLE_DECLARATION* table, char* name)
+{
+    int column_index = get_column_index(table, name);
+    if(column_index == -1)
+    {
+        printf("Cannot find column : %s\n", name);
+        error_exit("Cannot find column for GROUP BY\n");
+    }
+
+    TABLE_ITEM* column = *((TABLE_ITEM**)get_array_list_data(table->columns, column_index));
+    add_array_list_value(aggregate->group_columns, &column);
+}
+//NaN is a group of its own, a flag in front of every float keeps it apart from the other values
+void add_group_key_row(array_list* key, TABLE_ITEM* column, int row)
+{
+    if(column->type == FLOAT_TYPE)
+    {
+        float value = get_column_float(column, row);
+        add_array_list_char(key, value == value);
+        add_key_float(key, value);
+        return;
+    }
+
+    add_key_row(key, column, row);
+}
+int add_aggregate_group(HASH_AGGREGATE* aggregate, int row)
+{
+    AGGREGATE_VALUE value = {0, 0, 0, -1, -1};
+
+    add_array_list_int(aggregate->group_rows, row);
+    for(int i = 0; i < aggregate->items->count; i++)
+    {
+        add_array_list_value(aggregate->values, &value);
+    }
+
+    return aggregate->group_rows->count - 1;
+}
+//NaN has no value, it is left out of everything but COUNT(*)
+void update_aggregate_value(AGGREGATE_ITEM* item, AGGREGATE_VALUE* value, int row)
+{
+    TABLE_ITEM* column = item->column;
+
+    if(item->type == GROUP_AGGREGATE)
+    {
+        return;
+    }
+    if(column == NULL)
+    {
+        value->count++;
+        return;
+    }
+
+    if(column->type == INT_TYPE)
+    {
+        int int_value = get_column_int(column, row);
+        value->int_sum += int_value;
+        value->sum += int_value;
+    }
+    else if(column->type == FLOAT_TYPE)
+    {
+        float float_value = get_column_float(column, row);
+        if(float_value != float_value)
+        {
+            return;
+        }
+        value->sum += float_value;
+    }
+
+    if(item->type == MIN_AGGREGATE && (value->count == 0 || compare_column_rows(column, row, value->min_row) < 0))
+    {
+        value->min_row = row;
+    }
+    if(item->type == MAX_AGGREGATE && (value->count == 0 || compare_column_rows(column, row, value->max_row) > 0))
+    {
+        value->max_row = row;
+    }
+    value->count++;
+}
+//Without GROUP BY every row falls into one group, which exists even when no row matches
+void run_hash_aggregate(HASH_AGGREGATE* aggregate, ROW_SCAN* scan, TABLE_DECLARATION* table, linked_list* logic_list)
+{
+    int item_count = aggregate->items->count;
+
+    clear_hash_map(aggregate->groups);
+    clear_array_list(aggregate->group_rows);
+    clear_array_list(aggregate->values);
+    if(aggregate->group_columns->count == 0)
+    {
+        add_aggregate_group(aggregate, -1);
+    }
+
+    for(int i = begin_row_scan(scan, table, logic_list); i != -1; i = next_row_scan(scan))
+    {
+        int group = 0;
+        if(aggregate->group_columns->count > 0)
         {
-            char logic_data = ' ';
-            if(logic->data_size > 0)
+            clear_array_list(aggregate->key);
+            for(int j = 0; j < aggregate->group_columns->count; j++)
             {
-                logic_data = *(logic->data);
+                add_group_key_row(aggregate->key, *((TABLE_ITEM**)get_array_list_data(aggregate->group_columns, j)), i);
             }
-            char table_data = get_linked_list_data_char(table_item->rows, index);
 
-            if(logic->logic_type == 0)
-            {
-                if(!(logic_data == table_data))
-                {
-                    is_true = 0;
-                    break;
-                }
-            }
-            else if(logic->logic_type == 1)
-            {
-                if(!(table_data > logic_data))
-                {
-                    is_true = 0;
-                    break;
-                }
-            }
-            else if(logic->logic_type == 2)
-            {
-                if(!(table_data >= logic_data))
-                {
-                    is_true = 0;
-                    break;
-                }
-            }
-            else if(logic->logic_type == 3)
-            {
-                if(!(table_data < logic_data))
-                {
-                    is_true = 0;
-                    break;
-                }
-            }
-            else if(logic->logic_type == 4)
+            int* group_index = (int*)get_hash_map_data(aggregate->groups, aggregate->key->data, aggregate->key->count);
+            if(group_index == NULL)
             {
-                if(!(table_data <= logic_data))
-                {
-                    is_true = 0;
-                    break;
-                }
+                group = add_aggregate_group(aggregate, i);
+                put_hash_map_value(aggregate->groups, aggregate->key->data, aggregate->key->count, &group);
             }
-            else if(logic->logic_type == 5)
+            else
             {
-                if(!(table_data != logic_data))
-                {
-                    is_true = 0;
-                    break;
-                }
+                group = *group_index;
             }
         }
-        else if(table_item->type == VARCHAR_TYPE)
-        {
-            char* logic_data = logic->data;
-            char* table_data = get_linked_list_data_string(table_item->rows, index);
 
-            if(logic->logic_type == 0)
-            {
-                if(!(strcmp(table_data, logic_data) == 0))
-                {
-                    is_true = 0;
-                    break;
-                }
-            }
-            else if(logic->logic_type == 1)
-            {
-                if(!(strcmp(table_data, logic_data) > 0))
-                {
-                    is_true = 0;
-                    break;
-                }
-            }
-            else if(logic->logic_type == 2)
-            {
-                if(!(strcmp(table_data, logic_data) >= 0))
-                {
-                    is_true = 0;
-                    break;
-                }
-            }
-            else if(logic->logic_type == 3)
-            {
-                if(!(strcmp(table_data, logic_data) < 0))
-                {
-                    is_true = 0;
-                    break;
-                }
-            }
-            else if(logic->logic_type == 4)
-            {
-                if(!(strcmp(table_data, logic_data) <= 0))
-                {
-                    is_true = 0;
-                    break;
-                }
-            }
-            else if(logic->logic_type == 5)
-            {
-                if(!(strcmp(table_data, logic_data) != 0))
-                {
-                    is_true = 0;
-                    break;
-                }
-            }
+        AGGREGATE_VALUE* values = (AGGREGATE_VALUE*)get_array_list_data(aggregate->values, group * item_count);
+        for(int j = 0; j < item_count; j++)
+        {
+            update_aggregate_value((AGGREGATE_ITEM*)get_array_list_data(aggregate->items, j), values + j, i);
         }
     }
-
-    return is_true;
 }
+//Aggregates over no values print nan
+enum RESULT_TYPE get_aggregate_result_type(AGGREGATE_ITEM* item)
+{
+    if(item->type == COUNT_AGGREGATE || (item->type == SUM_AGGREGATE && item->column->type == INT_TYPE))
+    {
+        return RESULT_LONG;
+    }
+    else if(item->type == SUM_AGGREGATE || item->type == AVG_AGGREGATE)
+    {
+        return RESULT_DOUBLE;
+    }
 
-int is_true_on_logics(linked_list* logic_list, TABLE_DECLARATION* table, int index)
+    return get_column_result_type(item->column);
+}
+void write_aggregate_value(result_sink* sink, AGGREGATE_ITEM* item, AGGREGATE_VALUE* value, int group_row)
 {
-    int is_true = 1;
+    if(item->type == GROUP_AGGREGATE)
+    {
+        write_column_value(sink, item->column, group_row);
+    }
+    else if(item->type == COUNT_AGGREGATE)
+    {
+        write_result_cell_long(sink, value->count);
+    }
+    else if(value->count == 0)
+    {
+        write_result_cell_missing(sink);
+    }
+    else if(item->type == SUM_AGGREGATE && item->column->type == INT_TYPE)
+    {
+        write_result_cell_long(sink, value->int_sum);
+    }
+    else if(item->type == SUM_AGGREGATE)
+    {
+        write_result_cell_double(sink, value->sum);
+    }
+    else if(item->type == AVG_AGGREGATE)
+    {
+        write_result_cell_double(sink, item->column->type == INT_TYPE ? (double)value->int_sum / value->count : value->sum / value->count);
+    }
+    else
+    {
+        write_column_value(sink, item->column, item->type == MIN_AGGREGATE ? value->min_row : value->max_row);
+    }
+}
+void display_aggregate_rows(HASH_AGGREGATE* aggregate, ROW_SCAN* scan, TABLE_DECLARATION* table, linked_list* logic_list, ROW_ORDER* order, result_sink* sink)
+{
+    for(int i = 0; i < aggregate->items->count; i++)
+    {
+        AGGREGATE_ITEM* item = (AGGREGATE_ITEM*)get_array_list_data(aggregate->items, i);
+        if(item->type != GROUP_AGGREGATE)
+        {
+            continue;
+        }
 
-    for(int i = 0; i < logic_list->count; i++)
+        int is_grouped = 0;
+        for(int j = 0; j < aggregate->group_columns->count; j++)
+        {
+            is_grouped |= *((TABLE_ITEM**)get_array_list_data(aggregate->group_columns, j)) == item->column;
+        }
+        if(!is_grouped)
+        {
+            printf("Column %s is not in GROUP BY\n", item->label);
+            error_exit("Displayed columns have to be in GROUP BY\n");
+        }
+    }
+
+    write_display_title(sink, table, NULL);
+    for(int i = 0; i < aggregate->items->count; i++)
     {
-        LOGIC_ITEM* logic_item = *((LOGIC_ITEM**)get_linked_list_data(logic_list, i));
-        if(!is_true_on_logic(logic_item, table, index))
+        AGGREGATE_ITEM* item = (AGGREGATE_ITEM*)get_array_list_data(aggregate->items, i);
+        add_result_column(sink, NULL, item->label, get_aggregate_result_type(item));
+    }
+    begin_result_rows(sink);
+
+    run_hash_aggregate(aggregate, scan, table, logic_list);
+    for(int i = order->offset; i < get_order_end(order, aggregate->group_rows->count); i++)
+    {
+        int group_row = get_array_list_data_int(aggregate->group_rows, i);
+        AGGREGATE_VALUE* values = (AGGREGATE_VALUE*)get_array_list_data(aggregate->values, i * aggregate->items->count);
+
+        for(int j = 0; j < aggregate->items->count; j++)
         {
-            is_true = 0;
-            break;
+            write_aggregate_value(sink, (AGGREGATE_ITEM*)get_array_list_data(aggregate->items, j), values + j, group_row);
         }
+        end_result_row(sink);
     }
-    
-    return is_true;
+}
+void end_display_aggregate(HASH_AGGREGATE* aggregate)
+{
+    clear_array_list(aggregate->items);
+    clear_array_list(aggregate->group_columns);
+    clear_hash_map(aggregate->groups);
+    aggregate->is_active = 0;
 }
 
 enum INPUT_TYPE get_command_type(const char* command)
@@ -701,286 +3747,70 @@ enum INPUT_TYPE get_command_type(const char* command)
     {
         return CLEAR;
     }
-
-    return UNKNOWN;
-}
-
-enum VARIABLE_TYPE get_variable_type(const char* variable_type)
-{
-    if(strcmp(variable_type, INT_COMMAND) == 0)
-    {
-        return INT_TYPE;
-    }
-    else if(strcmp(variable_type, CHAR_COMMAND) == 0)
-    {
-        return CHAR_TYPE;
-    }
-    else if(strcmp(variable_type, FLOAT_COMMAND) == 0)
-    {
-        return FLOAT_TYPE;
-    }
-    else if(strcmp(variable_type, VARCHAR_COMMAND) == 0)
-    {
-        return VARCHAR_TYPE;
-    }
-
-    return UNKNOWN_TYPE;
-}
-
-int is_referenced_foreign_to_index(linked_list* tables, TABLE_DECLARATION* table, int index)
-{
-    for(int i = 0; i < table->columns->count; i++)
+    else if(strcmp(command, VACUUM_COMMAND) == 0)
     {
-        TABLE_ITEM* item = *((TABLE_ITEM**)get_linked_list_data(table->columns, i));
-        if(!item->is_primary)
-        {
-            continue;
-        }
-        for(int j = 0; j < tables->count; j++)
-        {
-            TABLE_DECLARATION* other_declaration = *((TABLE_DECLARATION**)get_linked_list_data(tables, j));
-            if(strcmp(other_declaration->name, table->name) == 0)
-            {
-                continue;
-            }
-
-            for(int k = 0; k < other_declaration->columns->count; k++)
-            {
-                TABLE_ITEM* other_item = *((TABLE_ITEM**)get_linked_list_data(other_declaration->columns, k));
-
-                if(!other_item->is_foreign)
-                {
-                    continue;
-                }
-                if(strcmp(other_item->foreign_target_table, table->name) == 0 && strcmp(other_item->foreign_target_column, item->name) == 0)
-                {
-                    if(item->type == INT_TYPE)
-                    {
-                        int item_data = get_linked_list_data_int(item->rows, index);
-                        for(int w = 0; w < other_item->rows->count; w++)
-                        {
-                            int other_data = get_linked_list_data_int(other_item->rows, w);
-
-                            if(other_data == item_data)
-                            {
-                                return 1;
-                            }
-                        }
-                    }
-                    else if(item->type == FLOAT_TYPE)
-                    {
-                        float item_data = get_linked_list_data_float(item->rows, index);
-                        for(int w = 0; w < other_item->rows->count; w++)
-                        {
-                            float other_data = get_linked_list_data_float(other_item->rows, w);
-
-                            if(other_data == item_data)
-                            {
-                                return 1;
-                            }
-                        }
-                    }
-                    else if(item->type == CHAR_TYPE)
-                    {
-                        char item_data = get_linked_list_data_char(item->rows, index);
-                        for(int w = 0; w < other_item->rows->count; w++)
-                        {
-                            char other_data = get_linked_list_data_char(other_item->rows, w);
-
-                            if(other_data == item_data)
-                            {
-                                return 1;
-                            }
-                        }
-                    }
-                    else if(item->type == VARCHAR_TYPE)
-                    {
-                        char* item_data = get_linked_list_data_string(item->rows, index);
-                        for(int w = 0; w < other_item->rows->count; w++)
-                        {
-                            char* other_data = get_linked_list_data_string(other_item->rows, w);
-
-                            if(strcmp(item_data, other_data) == 0)
-                            {
-                                return 1;
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        return VACUUM;
     }
-
-    return 0;
-}
-
-int is_referenced_foreign_to_index_update(linked_list* tables, TABLE_DECLARATION* table, int index, linked_list* update_items)
-{
-    for(int i = 0; i < table->columns->count; i++)
+    else if(strcmp(command, GROUP_COMMAND) == 0)
     {
-        TABLE_ITEM* item = *((TABLE_ITEM**)get_linked_list_data(table->columns, i));
-        if(!item->is_primary)
-        {
-            continue;
-        }
-
-        int found_ref = 0;
-        for(int j = 0; j < update_items->count; j++)
-        {
-            UPDATE_ITEM* update_item = *((UPDATE_ITEM**)get_linked_list_data(update_items, j));
-
-            if(update_item->column_index == i)
-            {
-                found_ref = 1;
-            }
-        }
-        if(found_ref == 0)
-        {
-            continue;
-        }
-        for(int j = 0; j < tables->count; j++)
-        {
-            TABLE_DECLARATION* other_declaration = *((TABLE_DECLARATION**)get_linked_list_data(tables, j));
-            if(strcmp(other_declaration->name, table->name) == 0)
-            {
-                continue;
-            }
-
-            for(int k = 0; k < other_declaration->columns->count; k++)
-            {
-                TABLE_ITEM* other_item = *((TABLE_ITEM**)get_linked_list_data(other_declaration->columns, k));
-
-                if(!other_item->is_foreign)
-                {
-                    continue;
-                }
-                if(strcmp(other_item->foreign_target_table, table->name) == 0 && strcmp(other_item->foreign_target_column, item->name) == 0)
-                {
-                    if(item->type == INT_TYPE)
-                    {
-                        int item_data = get_linked_list_data_int(item->rows, index);
-                        for(int w = 0; w < other_item->rows->count; w++)
-                        {
-                            int other_data = get_linked_list_data_int(other_item->rows, w);
-
-                            if(other_data == item_data)
-                            {
-                                return 1;
-                            }
-                        }
-                    }
-                    else if(item->type == FLOAT_TYPE)
-                    {
-                        float item_data = get_linked_list_data_float(item->rows, index);
-                        for(int w = 0; w < other_item->rows->count; w++)
-                        {
-                            float other_data = get_linked_list_data_float(other_item->rows, w);
-
-                            if(other_data == item_data)
-                            {
-                                return 1;
-                            }
-                        }
-                    }
-                    else if(item->type == CHAR_TYPE)
-                    {
-                        char item_data = get_linked_list_data_char(item->rows, index);
-                        for(int w = 0; w < other_item->rows->count; w++)
-                        {
-                            char other_data = get_linked_list_data_char(other_item->rows, w);
-
-                            if(other_data == item_data)
-                            {
-                                return 1;
-                            }
-                        }
-                    }
-                    else if(item->type == VARCHAR_TYPE)
-                    {
-                        char* item_data = get_linked_list_data_string(item->rows, index);
-                        for(int w = 0; w < other_item->rows->count; w++)
-                        {
-                            char* other_data = get_linked_list_data_string(other_item->rows, w);
-
-                            if(strcmp(item_data, other_data) == 0)
-                            {
-                                return 1;
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        return GROUP;
+    }
+    else if(strcmp(command, ORDER_COMMAND) == 0)
+    {
+        return ORDER;
+    }
+    else if(strcmp(command, LIMIT_COMMAND) == 0)
+    {
+        return LIMIT;
+    }
+    else if(strcmp(command, FORMAT_COMMAND) == 0)
+    {
+        return FORMAT;
     }
 
-    return 0;
+    return UNKNOWN;
 }
 
-int is_primary_referenced_on_table(TABLE_DECLARATION* table, char** data, int* data_size)
+enum VARIABLE_TYPE get_variable_type(const char* variable_type)
 {
-    char* dummy;
-    for(int i = 0; i < table->row_count; i++)
+    if(strcmp(variable_type, INT_COMMAND) == 0)
     {
-        int primary_count = 0;
-        int primary_check = 0;
-        for(int j = 0; j < table->columns->count; j++)
-        {
-            char* raw_data = *(data + j);
-            TABLE_ITEM* table_item = *((TABLE_ITEM**)get_linked_list_data(table->columns, j));
-
-            if(!table_item->is_primary)
-            {
-                continue;
-            }
-            primary_count += 1;
-
-            if(table_item->type == INT_TYPE)
-            {
-                int check_data = strtol(raw_data, &dummy, 10);
-                int item_data = get_linked_list_data_int(table_item->rows, i);
-
-                if(check_data == item_data)
-                {
-                    primary_check += 1;
-                }
-            }
-            else if(table_item->type == FLOAT_TYPE)
-            {
-                float check_data = strtof(raw_data, &dummy);
-                float item_data = get_linked_list_data_float(table_item->rows, i);
+        return INT_TYPE;
+    }
+    else if(strcmp(variable_type, CHAR_COMMAND) == 0)
+    {
+        return CHAR_TYPE;
+    }
+    else if(strcmp(variable_type, FLOAT_COMMAND) == 0)
+    {
+        return FLOAT_TYPE;
+    }
+    else if(strcmp(variable_type, VARCHAR_COMMAND) == 0)
+    {
+        return VARCHAR_TYPE;
+    }
 
-                if(check_data == item_data)
-                {
-                    primary_check += 1;
-                }
-            }
-            else if(table_item->type == CHAR_TYPE)
-            {
-                char check_data = ' ';
-                if(*(data_size + j) > 0)
-                {
-                    check_data = *(raw_data);
-                }
-                char item_data = get_linked_list_data_char(table_item->rows, i);
+    return UNKNOWN_TYPE;
+}
 
-                if(check_data == item_data)
-                {
-                    primary_check += 1;
-                }
-            }
-            else if(table_item->type == VARCHAR_TYPE)
-            {
-                char* check_data = raw_data;
-                char* item_data = get_linked_list_data_string(table_item->rows, i);
+//A row is referenced when a row of another table holds the value of one of its primary columns
+int is_column_referenced_at(TABLE_DECLARATION* table, TABLE_ITEM* column, int index)
+{
+    if(!column->is_primary || column->reference_counts == NULL)
+    {
+        return 0;
+    }
 
-                if(strcmp(check_data, item_data) == 0)
-                {
-                    primary_check += 1;
-                }
-            }
-        }
+    clear_array_list(table->key_buffer);
+    return add_key_row(table->key_buffer, column, index) && get_key_count(column->reference_counts, table->key_buffer) > 0;
+}
 
-        if(primary_count != 0 && primary_count == primary_check)
+int is_referenced_foreign_to_index(TABLE_DECLARATION* table, int index)
+{
+    for(int i = 0; i < table->columns->count; i++)
+    {
+        TABLE_ITEM* item = *((TABLE_ITEM**)get_array_list_data(table->columns, i));
+        if(is_column_referenced_at(table, item, index))
         {
             return 1;
         }
@@ -989,205 +3819,62 @@ int is_primary_referenced_on_table(TABLE_DECLARATION* table, char** data, int* d
     return 0;
 }
 
-int is_primary_referenced_on_update(TABLE_DECLARATION* table, linked_list* update_items, int index)
+int is_referenced_foreign_to_index_update(TABLE_DECLARATION* table, int index, linked_list* update_items)
 {
-    char* dummy;
-    for(int i = 0; i < table->row_count; i++)
+    for(int j = 0; j < update_items->count; j++)
     {
-        if(i == index)
-        {
-            continue;
-        }
-
-        int primary_count = 0;
-        int primary_check = 0;
+        UPDATE_ITEM* update_item = *((UPDATE_ITEM**)get_linked_list_data(update_items, j));
+        TABLE_ITEM* item = *((TABLE_ITEM**)get_array_list_data(table->columns, update_item->column_index));
 
-        for(int j = 0; j < table->columns->count; j++)
+        if(is_column_referenced_at(table, item, index))
         {
-            char* raw_data = NULL;
-            int raw_size;
-            TABLE_ITEM* table_item = *((TABLE_ITEM**)get_linked_list_data(table->columns, j));
-
-            if(!table_item->is_primary)
-            {
-                continue;
-            }
-            
-            int use_raw = 0;
-
-            for(int k = 0; k < update_items->count; k++)
-            {
-                UPDATE_ITEM* current_update = *((UPDATE_ITEM**)get_linked_list_data(update_items, k));
-                if(current_update->column_index == j)
-                {
-                    use_raw = 1;
-                    raw_data = current_update->data;
-                    raw_size = current_update->data_size;
-                }
-            }
-
-            primary_count += 1;
-
-            if(table_item->type == INT_TYPE)
-            {
-                int check_data;
-                if(use_raw)
-                {
-                    check_data = strtol(raw_data, &dummy, 10);
-                }
-                else
-                {
-                    check_data = get_linked_list_data_int(table_item->rows, index);
-                }
-                int item_data = get_linked_list_data_int(table_item->rows, i);
-
-                if(check_data == item_data)
-                {
-                    primary_check += 1;
-                }
-            }
-            else if(table_item->type == FLOAT_TYPE)
-            {
-                float check_data;
-                if(use_raw)
-                {
-                    check_data = strtof(raw_data, &dummy);
-                }
-                else
-                {
-                    check_data = get_linked_list_data_float(table_item->rows, index);
-                }
-                float item_data = get_linked_list_data_float(table_item->rows, i);
+            return 1;
+        }
+    }
 
-                if(check_data == item_data)
-                {
-                    primary_check += 1;
-                }
-            }
-            else if(table_item->type == CHAR_TYPE)
-            {
-                char check_data = ' ';
-                if(use_raw)
-                {
-                    if(raw_size > 0)
-                    {
-                        check_data = *(raw_data);
-                    }
-                }
-                else
-                {
-                    check_data = get_linked_list_data_char(table_item->rows, index);
-                }
-                char item_data = get_linked_list_data_char(table_item->rows, i);
+    return 0;
+}
 
-                if(check_data == item_data)
-                {
-                    primary_check += 1;
-                }
-            }
-            else if(table_item->type == VARCHAR_TYPE)
-            {
-                char* check_data;
-                if(use_raw)
-                {
-                    check_data = raw_data;
-                }
-                else
-                {
-                    check_data = get_linked_list_data_string(table_item->rows, index);
-                }
-                char* item_data = get_linked_list_data_string(table_item->rows, i);
+int is_primary_referenced_on_table(TABLE_DECLARATION* table, char** data, int* data_size)
+{
+    if(table->primary_index == NULL || !build_primary_data_key(table, data, data_size))
+    {
+        return 0;
+    }
 
-                if(strcmp(check_data, item_data) == 0)
-                {
-                    primary_check += 1;
-                }
-            }
-        }
+    return get_hash_map_data(table->primary_index, table->key_buffer->data, table->key_buffer->count) != NULL;
+}
 
-        if(primary_count != 0 && primary_count == primary_check)
-        {
-            return 1;
-        }
+int is_primary_referenced_on_update(TABLE_DECLARATION* table, linked_list* update_items, int index)
+{
+    if(table->primary_index == NULL || !build_primary_update_key(table, update_items, index))
+    {
+        return 0;
     }
 
-    return 0;
+    int* row = (int*)get_hash_map_data(table->primary_index, table->key_buffer->data, table->key_buffer->count);
+    return row != NULL && *row != index;
 }
 
-int is_foreign_data_valid(linked_list* tables, TABLE_DECLARATION* table, char** data, int* data_size)
+//Probes the value count index of the referenced column, key holds the serialized value
+int is_foreign_key_present(TABLE_ITEM* column, array_list* key)
+{
+    return get_key_count(column->foreign_column->value_counts, key) > 0;
+}
+
+int is_foreign_data_valid(TABLE_DECLARATION* table, char** data, int* data_size)
 {
-    char* dummy;
     for(int i = 0; i < table->columns->count; i++)
     {
-        TABLE_ITEM* table_item = *((TABLE_ITEM**)get_linked_list_data(tables, i));
-        char* raw_data = *(data + i);
-        int raw_size = *(data_size + i);
+        TABLE_ITEM* table_item = *((TABLE_ITEM**)get_array_list_data(table->columns, i));
 
         if(!table_item->is_foreign)
         {
             continue;
         }
 
-        int target_table = get_table_index(tables, table_item->foreign_target_table);
-        TABLE_DECLARATION* table_declaration = *((TABLE_DECLARATION**)get_linked_list_data(tables, target_table));
-        int target_column = get_column_index(table_declaration, table_item->foreign_target_column);
-        TABLE_ITEM* other_item = *((TABLE_ITEM**)get_linked_list_data(table_declaration->columns, target_column));
-
-        int found_foreign = 0;
-        if(table_item->type == INT_TYPE)
-        {
-            int item_data = strtol(raw_data, &dummy, 10);
-            for(int j = 0; j < table_declaration->row_count; j++)
-            {
-                int other_data = get_linked_list_data_int(other_item->rows, j);
-                if(other_data == item_data)
-                {
-                    found_foreign = 1;
-                }
-            }
-        }
-        else if(table_item->type == FLOAT_TYPE)
-        {
-            float item_data = strtof(raw_data, &dummy);
-            for(int j = 0; j < table_declaration->row_count; j++)
-            {
-                float other_data = get_linked_list_data_float(other_item->rows, j);
-                if(other_data == item_data)
-                {
-                    found_foreign = 1;
-                }
-            }
-        }
-        else if(table_item->type == CHAR_TYPE)
-        {
-            char item_data = ' ';
-            if(raw_size > 0)
-            {
-                item_data = *(raw_data);
-            }
-            for(int j = 0; j < table_declaration->row_count; j++)
-            {
-                char other_data = get_linked_list_data_char(other_item->rows, j);
-                if(other_data == item_data)
-                {
-                    found_foreign = 1;
-                }
-            }
-        }
-        else if(table_item->type = VARCHAR_TYPE)
-        {
-            char* item_data = raw_data;
-            for(int j = 0; j < table_declaration->row_count; j++)
-            {
-                char* other_data = get_linked_list_data_string(other_item->rows, j);
-                if(strcmp(other_data, item_data) == 0)
-                {
-                    found_foreign = 1;
-                }
-            }
-        }
-
-        if(found_foreign == 0)
+        clear_array_list(table->key_buffer);
+        if(!add_key_data(table->key_buffer, table_item, *(data + i), *(data_size + i)) || !is_foreign_key_present(table_item, table->key_buffer))
         {
             return 0;
         }
@@ -1196,122 +3883,30 @@ int is_foreign_data_valid(linked_list* tables, TABLE_DECLARATION* table, char**
     return 1;
 }
 
-int is_foreign_data_valid_on_update(linked_list* tables, TABLE_DECLARATION* table, linked_list* update_items, int index)
+int is_foreign_data_valid_on_update(TABLE_DECLARATION* table, linked_list* update_items, int index)
 {
-    char* dummy;
     for(int i = 0; i < table->columns->count; i++)
     {
-        TABLE_ITEM* table_item = *((TABLE_ITEM**)get_linked_list_data(table->columns, i));
-        char* raw_data = NULL;
-        int raw_size;
-        int use_raw = 0;
+        TABLE_ITEM* table_item = *((TABLE_ITEM**)get_array_list_data(table->columns, i));
+        UPDATE_ITEM* update = NULL;
 
         if(!table_item->is_foreign)
         {
             continue;
         }
 
-        int target_table = get_table_index(tables, table_item->foreign_target_table);
-        TABLE_DECLARATION* table_declaration = *((TABLE_DECLARATION**)get_linked_list_data(tables, target_table));
-        int target_column = get_column_index(table_declaration, table_item->foreign_target_column);
-        TABLE_ITEM* other_item = *((TABLE_ITEM**)get_linked_list_data(table_declaration->columns, target_column));
-
         for(int j = 0; j < update_items->count; j++)
         {
             UPDATE_ITEM* current_item = *((UPDATE_ITEM**)get_linked_list_data(update_items, j));
             if(current_item->column_index == i)
             {
-                use_raw = 1;
-                raw_data = current_item->data;
-                raw_size = current_item->data_size;
-            }
-        }
-
-        int found_foreign = 0;
-        if(table_item->type == INT_TYPE)
-        {
-            int item_data;
-            if(use_raw)
-            {
-                item_data = strtol(raw_data, &dummy, 10);
-            }
-            else
-            {
-                item_data = get_linked_list_data_int(table_item->rows, index);
-            }
-
-            for(int j = 0; j < table_declaration->row_count; j++)
-            {
-                int other_data = get_linked_list_data_int(other_item->rows, j);
-                if(other_data == item_data)
-                {
-                    found_foreign = 1;
-                }
-            }
-        }
-        else if(table_item->type == FLOAT_TYPE)
-        {
-            float item_data;
-            if(use_raw)
-            {
-                item_data = strtof(raw_data, &dummy);
-            }
-            else
-            {
-                item_data = get_linked_list_data_float(table_item->rows, index);
-            }
-
-            for(int j = 0; j < table_declaration->row_count; j++)
-            {
-                float other_data = get_linked_list_data_float(other_item->rows, j);
-                if(other_data == item_data)
-                {
-                    found_foreign = 1;
-                }
-            }
-        }
-        else if(table_item->type == CHAR_TYPE)
-        {
-            char item_data = ' ';
-            if(use_raw)
-            {
-                if(raw_size > 0)
-                {
-                    item_data = *(raw_data);
-                }
-            }
-            else
-            {
-                item_data = get_linked_list_data_char(table_item->rows, index);
-            }
-
-            for(int j = 0; j < table_declaration->row_count; j++)
-            {
-                char other_data = get_linked_list_data_char(other_item->rows, j);
-                if(other_data == item_data)
-                {
-                    found_foreign = 1;
-                }
-            }
-        }
-        else if(table_item->type = VARCHAR_TYPE)
-        {
-            char* item_data = raw_data;
-            if(!use_raw)
-            {
-                item_data = get_linked_list_data_string(table_item->rows, index);
-            }
-            for(int j = 0; j < table_declaration->row_count; j++)
-            {
-                char* other_data = get_linked_list_data_string(other_item->rows, j);
-                if(strcmp(other_data, item_data) == 0)
-                {
-                    found_foreign = 1;
-                }
+                update = current_item;
             }
         }
 
-        if(found_foreign == 0)
+        clear_array_list(table->key_buffer);
+        int is_indexed = update != NULL ? add_key_data(table->key_buffer, table_item, update->data, update->data_size) : add_key_row(table->key_buffer, table_item, index);
+        if(!is_indexed || !is_foreign_key_present(table_item, table->key_buffer))
         {
             return 0;
         }
@@ -1320,10 +3915,10 @@ int is_foreign_data_valid_on_update(linked_list* tables, TABLE_DECLARATION* tabl
     return 1;
 }
 
-void update_table_column_at(linked_list* tables, TABLE_DECLARATION* update_table, linked_list* update_items, int index)
+void update_table_column_at(TABLE_DECLARATION* update_table, linked_list* update_items, int index)
 {
     char* dummy;
-    if(is_referenced_foreign_to_index_update(tables, update_table, index, update_items))
+    if(is_referenced_foreign_to_index_update(update_table, index, update_items))
     {
         error_exit("Fatal error when updating column, row is foreign referenced\n");
     }
@@ -1331,41 +3926,38 @@ void update_table_column_at(linked_list* tables, TABLE_DECLARATION* update_table
     {
         error_exit("Fatal error when updating column, the same column with the same primary keys is detected\n");
     }
-    if(!is_foreign_data_valid_on_update(tables, update_table, update_items, index))
+    if(!is_foreign_data_valid_on_update(update_table, update_items, index))
     {
         error_exit("Fatal error when updating column, cannot find reference foreign key on target\n");
     }
 
+    unindex_table_row(update_table, index);
     for(int i = 0; i < update_items->count; i++)
     {
         UPDATE_ITEM* current_update = *((UPDATE_ITEM**)get_linked_list_data(update_items, i));
-        TABLE_ITEM* update_column = *((TABLE_ITEM**)get_linked_list_data(update_table->columns, current_update->column_index));
+        TABLE_ITEM* update_column = *((TABLE_ITEM**)get_array_list_data(update_table->columns, current_update->column_index));
 
         if(update_column->type == INT_TYPE)
         {
             int val = strtol(current_update->data, &dummy, 10);
-            set_linked_list_value_int_at(update_column->rows, index, val);
+            set_column_int(update_column, index, val);
         }
         else if(update_column->type == FLOAT_TYPE)
         {
             float val = strtof(current_update->data, &dummy);
-            set_linked_list_value_float_at(update_column->rows, index, val);
+            set_column_float(update_column, index, val);
         }
         else if(update_column->type == CHAR_TYPE)
         {
-            char val = ' ';
-            if(update_column->data_size > 0)
-            {
-                val = *(current_update->data);
-            }
-            set_linked_list_value_char_at(update_column->rows, index, val);
+            set_column_char(update_column, index, get_char_value(current_update->data, current_update->data_size));
         }
         else if(update_column->type == VARCHAR_TYPE)
         {
             char* val = current_update->data;
-            set_linked_list_value_string_at_safe(update_column->rows, index, val);
+            set_column_string(update_column, index, val);
         }
     }
+    index_table_row(update_table, index);
 }
 
 FILE* script = NULL;
@@ -1380,11 +3972,16 @@ void run()
     int error = 0;
     const char* error_message = "";
 
+    //Tokens live until the next line, logic and update items until the statement ends
+    arena* line_memory = allocate_arena(BUFFER_SIZE * 4);
+    arena* statement_memory = allocate_arena(BUFFER_SIZE * 4);
+
     //Logics
     linked_list* logics = allocate_linked_list(sizeof(LOGIC_ITEM*));
+    ROW_SCAN* scan = allocate_row_scan();
 
     //Tables
-    linked_list* tables = allocate_linked_list(sizeof(TABLE_DECLARATION*));
+    TABLE_CATALOG* tables = allocate_table_catalog();
 
     //Create
     TABLE_DECLARATION* create_table = NULL;
@@ -1393,11 +3990,19 @@ void run()
     TABLE_DECLARATION* insert_table = NULL;
 
     //Display
-    linked_list* display_column = allocate_linked_list(sizeof(char*));
+    array_list* display_columns = allocate_array_list(sizeof(TABLE_ITEM*));
     TABLE_DECLARATION* display_table = NULL;
+    HASH_JOIN* display_join = allocate_hash_join();
+    HASH_AGGREGATE* display_aggregate = allocate_hash_aggregate();
+    ROW_ORDER* display_order = allocate_row_order();
+    result_writer* output = allocate_result_writer(stdout);
+    result_sink* display_sink = allocate_result_sink(output);
+    char* display_into = NULL;
+    FILE* display_file = NULL;
 
     //Delete
     TABLE_DECLARATION* delete_table_where = NULL;
+    array_list* delete_rows = allocate_array_list(sizeof(int));
 
     //Update
     TABLE_DECLARATION* update_table = NULL;
@@ -1428,7 +4033,7 @@ void run()
             scanf("%c", dummy);
         }
 
-        parsedata* tokens = parse(buffer, BUFFER_SIZE, " \t", 2, "\"", 1);
+        parsedata* tokens = parse_on_arena(line_memory, buffer, BUFFER_SIZE, " \t", 2, "\"", 1);
 
         if(input_type == EMPTY)
         {
@@ -1448,10 +4053,65 @@ void run()
                     error_message = "Syntax error for command : PRINT\n";
                     goto pass;
                 }
-                printf("%s\n", tokens->data[1]);
-            }
-            else if(command_type == CREATE)
-            {
+                printf("%s\n", tokens->data[1]);
+            }
+            else if(command_type == CREATE)
+            {
+                //CREATE INDEX [TABLE] [COLUMN] [BITMAP] builds an ordered or bitmap index over the rows already in the table
+                if((tokens->length == 4 || tokens->length == 5) && strcmp(tokens->data[1], INDEX_COMMAND) == 0)
+                {
+                    int is_bitmap = tokens->length == 5;
+                    if(is_bitmap && strcmp(tokens->data[4], BITMAP_COMMAND) != 0)
+                    {
+                        error = 1;
+                        error_message = "Syntax error for command : CREATE INDEX [TABLE] [COLUMN] [BITMAP]\n";
+                        goto pass;
+                    }
+
+                    int table_index = get_table_index(tables, tokens->data[2]);
+                    if(table_index == -1)
+                    {
+                        error = 1;
+                        printf("Error when creating index, cannot find table : %s\n", tokens->data[2]);
+                        error_message = "Error when creating index, cannot find target table\n";
+                        goto pass;
+                    }
+                    TABLE_DECLARATION* index_table = *((TABLE_DECLARATION**)get_array_list_data(tables->declarations, table_index));
+
+                    int column_index = get_column_index(index_table, tokens->data[3]);
+                    if(column_index == -1)
+                    {
+                        error = 1;
+                        printf("Error when creating index, cannot find column %s on table %s\n", tokens->data[3], index_table->name);
+                        error_message = "Error when creating index, cannot find target column\n";
+                        goto pass;
+                    }
+                    TABLE_ITEM* index_column = *((TABLE_ITEM**)get_array_list_data(index_table->columns, column_index));
+
+                    if(is_bitmap ? index_column->bitmap_index != NULL : index_column->ordered_index != NULL)
+                    {
+                        error = 1;
+                        printf("Error when creating index, column %s on table %s\n", index_column->name, index_table->name);
+                        error_message = "Error when creating index, the column is already indexed\n";
+                        goto pass;
+                    }
+
+                    if(!is_bitmap)
+                    {
+                        make_ordered_index_column(index_table, index_column);
+                        goto pass;
+                    }
+
+                    //Bitmaps are kept per distinct value, so only columns with a small domain can have one
+                    if(index_column->type != CHAR_TYPE && index_column->dictionary == NULL)
+                    {
+                        error = 1;
+                        error_message = "Error when creating index, only CHAR and DICTIONARY columns can have a BITMAP index\n";
+                        goto pass;
+                    }
+                    make_bitmap_index_column(index_table, index_column);
+                    goto pass;
+                }
                 if(tokens->length != 2)
                 {
                     error = 1;
@@ -1501,11 +4161,17 @@ void run()
                     goto pass;
                 }
 
-                insert_table = *((TABLE_DECLARATION**)get_linked_list_data(tables, index));
+                insert_table = *((TABLE_DECLARATION**)get_array_list_data(tables->declarations, index));
             }
             else if(command_type == DISPLAY)
             {
                 input_type = DISPLAY;
+                if(tokens->length >= 10 && strcmp(tokens->data[tokens->length - 6], JOIN_COMMAND) == 0)
+                {
+                    begin_display_join(display_join, tables, tokens, logics);
+                    display_table = display_join->left_table;
+                    goto pass;
+                }
                 if(tokens->length < 4)
                 {
                     error = 1;
@@ -1526,19 +4192,34 @@ void run()
                     error_message = "Cannot find table for DISPLAY\n";
                     goto pass;
                 }
-                TABLE_DECLARATION* get_display_table = *((TABLE_DECLARATION**)get_linked_list_data(tables, table_index));
+                TABLE_DECLARATION* get_display_table = *((TABLE_DECLARATION**)get_array_list_data(tables->declarations, table_index));
 
                 if(tokens->length == 4 && strcmp(tokens->data[1], ALL_COMMAND) == 0)
                 {
                     display_table = get_display_table;
                     for(int i = 0; i < get_display_table->columns->count; i++)
                     {
-                        TABLE_ITEM* table_item = *((TABLE_ITEM**)get_linked_list_data(get_display_table->columns, i));
-                        add_linked_list_value(display_column, &table_item->name);
+                        add_array_list_value(display_columns, get_array_list_data(get_display_table->columns, i));
                     }
                 }
                 else
                 {
+                    int is_aggregate = 0;
+                    for(int i = 1; i < tokens->length - 2; i++)
+                    {
+                        is_aggregate |= strchr(tokens->data[i], '(') != NULL;
+                    }
+                    if(is_aggregate)
+                    {
+                        display_table = get_display_table;
+                        for(int i = 1; i < tokens->length - 2; i++)
+                        {
+                            add_aggregate_item(display_aggregate, statement_memory, get_display_table, tokens->data[i]);
+                        }
+                        display_aggregate->is_active = 1;
+                        goto pass;
+                    }
+
                     for(int i = 1; i < tokens->length - 2; i++)
                     {
                         int column_index = get_column_index(get_display_table, tokens->data[i]);
@@ -1555,8 +4236,7 @@ void run()
                     for(int i = 1; i < tokens->length - 2; i++)
                     {
                         int column_index = get_column_index(get_display_table, tokens->data[i]);
-                        TABLE_ITEM* table_item = *((TABLE_ITEM**)get_linked_list_data(get_display_table->columns, column_index));
-                        add_linked_list_value(display_column, &table_item->name);
+                        add_array_list_value(display_columns, get_array_list_data(get_display_table->columns, column_index));
                     }
                 }
             }
@@ -1583,11 +4263,11 @@ void run()
 
                         if(strcmp(tokens->data[4], ALL_COMMAND) == 0)
                         {
-                            TABLE_DECLARATION* delete_table = *((TABLE_DECLARATION**)get_linked_list_data(tables, table_index));
+                            TABLE_DECLARATION* delete_table = *((TABLE_DECLARATION**)get_array_list_data(tables->declarations, table_index));
 
-                            for(int i = 0; i < delete_table->row_count; i++)
+                            for(int i = get_first_table_row(delete_table); i != -1; i = get_next_table_row(delete_table, i))
                             {
-                                int is_foreign_referenced = is_referenced_foreign_to_index(tables, delete_table, i);
+                                int is_foreign_referenced = is_referenced_foreign_to_index(delete_table, i);
                                 if(is_foreign_referenced)
                                 {
                                     error = 1;
@@ -1596,19 +4276,16 @@ void run()
                                     goto pass;
                                 }
                             }
-                            while (delete_table->row_count > 0)
-                            {
-                                delete_table_row(delete_table, 0);
-                            }
+                            clear_table_rows(delete_table);
                         }
                         else
                         {
                             char* dummy_ptr;
                             int row_index = strtol(tokens->data[4], &dummy_ptr, 10);
 
-                            TABLE_DECLARATION* delete_table = *((TABLE_DECLARATION**)get_linked_list_data(tables, table_index));
+                            TABLE_DECLARATION* delete_table = *((TABLE_DECLARATION**)get_array_list_data(tables->declarations, table_index));
 
-                            if(row_index >= delete_table->row_count)
+                            if(row_index < 0 || row_index >= delete_table->row_count)
                             {
                                 error = 1;
                                 printf("Error when deleting, index is outside of bounds on table : %s, at %i\n", tokens->data[2], row_index);
@@ -1616,7 +4293,8 @@ void run()
                                 goto pass;
                             }
                             
-                            int is_foreign_referenced = is_referenced_foreign_to_index(tables, delete_table, row_index);
+                            int row = get_table_row_at(delete_table, row_index);
+                            int is_foreign_referenced = is_referenced_foreign_to_index(delete_table, row);
 
                             if(is_foreign_referenced)
                             {
@@ -1626,7 +4304,8 @@ void run()
                                 goto pass;
                             }
 
-                            delete_table_row(delete_table, row_index);
+                            delete_table_row(delete_table, row);
+                            vacuum_table_on_threshold(delete_table);
                         }
                     }
                     else
@@ -1652,7 +4331,7 @@ void run()
                         }
                     }
 
-                    delete_table_where = *((TABLE_DECLARATION**)get_linked_list_data(tables, table_index));
+                    delete_table_where = *((TABLE_DECLARATION**)get_array_list_data(tables->declarations, table_index));
 
                     input_type = DELETE;
                 }
@@ -1682,7 +4361,7 @@ void run()
                         error_message = "Error when updating, target table does not exist\n";
                         goto pass;
                     }
-                    update_table = *((TABLE_DECLARATION**)get_linked_list_data(tables, table_index));
+                    update_table = *((TABLE_DECLARATION**)get_array_list_data(tables->declarations, table_index));
 
                     update_table_at = -1;
                     input_type = UPDATE;
@@ -1707,7 +4386,7 @@ void run()
                     char* dummy_ptr;
                     int row_index = strtol(tokens->data[3], &dummy_ptr, 10);
 
-                    TABLE_DECLARATION* temp_table = *((TABLE_DECLARATION**)get_linked_list_data(tables, table_index));
+                    TABLE_DECLARATION* temp_table = *((TABLE_DECLARATION**)get_array_list_data(tables->declarations, table_index));
                     if(row_index < 0 || row_index >= temp_table->row_count)
                     {
                         error = 1;
@@ -1716,7 +4395,7 @@ void run()
                         goto pass;
                     }
 
-                    update_table_at = row_index;
+                    update_table_at = get_table_row_at(temp_table, row_index);
                     update_table = temp_table;
                     input_type = UPDATE;
                 }
@@ -1736,9 +4415,9 @@ void run()
                     goto pass;
                 }
 
-                for(int i = 0; i < tables->count; i++)
+                for(int i = 0; i < tables->declarations->count; i++)
                 {
-                    TABLE_DECLARATION* table = *((TABLE_DECLARATION**)get_linked_list_data(tables, i));
+                    TABLE_DECLARATION* table = *((TABLE_DECLARATION**)get_array_list_data(tables->declarations, i));
                     printf("%s\n", table->name);
                 }
             }
@@ -1779,6 +4458,36 @@ void run()
 
                 clear_all_table(tables);
             }
+            else if(command_type == VACUUM)
+            {
+                if(tokens->length > 2)
+                {
+                    error = 1;
+                    error_message = "Syntax error for command : VACUUM\n";
+                    goto pass;
+                }
+
+                if(tokens->length == 2)
+                {
+                    int table_index = get_table_index(tables, tokens->data[1]);
+                    if(table_index == -1)
+                    {
+                        error = 1;
+                        printf("Error when vacuuming, cannot find table : %s\n", tokens->data[1]);
+                        error_message = "Error when vacuuming, cannot find target table\n";
+                        goto pass;
+                    }
+
+                    vacuum_table(*((TABLE_DECLARATION**)get_array_list_data(tables->declarations, table_index)));
+                }
+                else
+                {
+                    for(int i = 0; i < tables->declarations->count; i++)
+                    {
+                        vacuum_table(*((TABLE_DECLARATION**)get_array_list_data(tables->declarations, i)));
+                    }
+                }
+            }
             else if(command_type == END)
             {
                 loop = 0;
@@ -1803,9 +4512,24 @@ void run()
             enum VARIABLE_TYPE variable_type = get_variable_type(tokens->data[0]);
             enum INPUT_TYPE command_type = get_command_type(tokens->data[0]);
 
+            //A trailing DICTIONARY asks for dictionary encoding, the rest of the declaration is read without it
+            int token_count = tokens->length;
+            int is_dictionary = 0;
+            if(variable_type != UNKNOWN_TYPE && token_count > (variable_type == VARCHAR_TYPE ? 3 : 2) && strcmp(tokens->data[token_count - 1], DICTIONARY_COMMAND) == 0)
+            {
+                if(variable_type != CHAR_TYPE && variable_type != VARCHAR_TYPE)
+                {
+                    error = 1;
+                    error_message = "Error when creating table, only CHAR and VARCHAR columns can be DICTIONARY\n";
+                    goto pass;
+                }
+                is_dictionary = 1;
+                token_count -= 1;
+            }
+
             if(variable_type == VARCHAR_TYPE)
             {
-                if(tokens->length < 3 || tokens->length > 6)
+                if(token_count < 3 || token_count > 6)
                 {
                     error = 1;
                     error_message = "Error when creating table, syntax error for variable VARCHAR size name [PRIMARY/FOREIGN/EMPTY] [FOREIGN TARGET TABLE] [FOREIGN TARGET COLUMN]\n";
@@ -1845,7 +4569,7 @@ void run()
                 char* target_foreign_table = NULL;
                 char* target_foreign_column = NULL;
 
-                if(tokens->length == 4)
+                if(token_count == 4)
                 {
                     if(strcmp(PRIMARY_COMMAND, tokens->data[3]) != 0)
                     {
@@ -1855,9 +4579,9 @@ void run()
                     }
                     is_primary = 1;
                 }
-                else if(tokens->length > 3)
+                else if(token_count > 3)
                 {
-                    if(tokens->length != 6)
+                    if(token_count != 6)
                     {
                         error = 1;
                         error_message = "Error when creating table, syntax error for foreign variable VARCHAR size name [PRIMARY/FOREIGN/EMPTY] [FOREIGN TARGET TABLE] [FOREIGN TARGET COLUMN]\n";
@@ -1884,11 +4608,15 @@ void run()
                 }
                 
                 TABLE_ITEM* item = create_table_item(variable_type, copy_string(tokens->data[2], tokens->size[2]), varchar_size);
+                if(is_dictionary)
+                {
+                    make_dictionary_column(item);
+                }
                 add_table_item(tables, create_table, item, is_primary, is_foreign, target_foreign_table, target_foreign_column);
             }
             else if(variable_type != UNKNOWN_TYPE)
             {
-                if(tokens->length < 2 || tokens->length > 5)
+                if(token_count < 2 || token_count > 5)
                 {
                     error = 1;
 
@@ -1928,7 +4656,7 @@ void run()
                 char* target_foreign_table = NULL;
                 char* target_foreign_column = NULL;
 
-                if(tokens->length == 3)
+                if(token_count == 3)
                 {
                     if(strcmp(PRIMARY_COMMAND, tokens->data[2]) != 0)
                     {
@@ -1938,9 +4666,9 @@ void run()
                     }
                     is_primary = 1;
                 }
-                else if(tokens->length > 2)
+                else if(token_count > 2)
                 {
-                    if(tokens->length != 5)
+                    if(token_count != 5)
                     {
                         error = 1;
                         error_message = "Error when creating table, syntax error for foreign variable TYPE size name [PRIMARY/FOREIGN/EMPTY] [FOREIGN TARGET TABLE] [FOREIGN TARGET COLUMN]\n";
@@ -1967,13 +4695,17 @@ void run()
                 }
 
                 TABLE_ITEM* item = create_table_item(variable_type, copy_string(tokens->data[1], tokens->size[1]), 0);
+                if(is_dictionary)
+                {
+                    make_dictionary_column(item);
+                }
                 add_table_item(tables, create_table, item, is_primary, is_foreign, target_foreign_table, target_foreign_column);
             }
             else
             {
                 if(command_type == END)
                 {
-                    if(tokens->length != 1)
+                    if(token_count != 1)
                     {
                         error = 1;
                         error_message = "Error when creating table, syntax error when ending declaration\n";
@@ -1987,7 +4719,7 @@ void run()
                     }
                     
                     input_type = EMPTY;
-                    add_linked_list_value(tables, &create_table);
+                    add_catalog_table(tables, create_table);
                     create_table = NULL;
                 }
                 else
@@ -2019,174 +4751,58 @@ void run()
                 }
 
                 //Check Primary
-                for(int x = 0; x < insert_table->row_count; x++)
+                if(is_primary_referenced_on_table(insert_table, tokens->data + 1, tokens->size + 1))
                 {
-                    int primary_count = 0;
-                    int primary_check = 0;
-
-                    for(int i = 0; i < insert_table->columns->count; i++)
-                    {
-                        TABLE_ITEM* column = *((TABLE_ITEM**)get_linked_list_data(insert_table->columns, i));
-                        char* data = tokens->data[i + 1];
-                        int data_len = tokens->size[i + 1];
-                        char* residual;
-
-                        if(column->is_primary)
-                        {
-                            primary_count += 1;
-
-                            switch (column->type)
-                            {
-                                case INT_TYPE:
-                                int integer = strtol(data, &residual, 10);
-                                if(integer == get_linked_list_data_int(column->rows, x))
-                                {
-                                    primary_check += 1;
-                                }
-                                break;
-                                case FLOAT_TYPE:
-                                float floating = strtof(data, &residual);
-                                if(integer == get_linked_list_data_float(column->rows, x))
-                                {
-                                    primary_check += 1;
-                                }
-                                break;
-                                case CHAR_TYPE:
-                                char character = ' ';
-                                if(data_len > 0)
-                                {
-                                    character = *(data);
-                                }
-                                if(character == get_linked_list_data_char(column->rows, x))
-                                {
-                                    primary_check += 1;
-                                }
-                                break;
-                                case VARCHAR_TYPE:
-                                char* string = get_linked_list_data_string(column->rows, x);
-                                if(strcmp(string, data))
-                                {
-                                    primary_check += 1;
-                                }
-                                break;
-                            }
-                        }
-                    }
-                    if(primary_count == primary_check && primary_check != 0)
-                    {
-                        error = 1;
-                        printf("Error inserting value, same primary keys detected\n");
-                        error_message = "Error when inserting table, all primary keys are equal\n";
-                        goto pass;
-                    }
+                    error = 1;
+                    printf("Error inserting value, same primary keys detected\n");
+                    error_message = "Error when inserting table, all primary keys are equal\n";
+                    goto pass;
                 }
 
                 //Check Foreign
                 for(int x = 0; x < insert_table->columns->count; x++)
                 {
-                    TABLE_ITEM* column = *((TABLE_ITEM**)get_linked_list_data(insert_table->columns, x));
+                    TABLE_ITEM* column = *((TABLE_ITEM**)get_array_list_data(insert_table->columns, x));
                     char* data = tokens->data[x + 1];
                     int data_len = tokens->size[x + 1];
                     char* residual;
 
-                    if(column->is_foreign)
+                    if(!column->is_foreign)
                     {
-                        int foreign_table_index = get_table_index(tables, column->foreign_target_table);
-                        TABLE_DECLARATION* foreign_table = *((TABLE_DECLARATION**)get_linked_list_data(tables, foreign_table_index));
-                        int foreign_column_index = get_column_index(foreign_table, column->foreign_target_column);
-                        TABLE_ITEM* foreign_column = *((TABLE_ITEM**)get_linked_list_data(foreign_table->columns, foreign_column_index));
+                        continue;
+                    }
 
-                        int found_foreign = 0;
-                        switch (column->type)
-                        {
-                            case INT_TYPE:
-                            int integer = strtol(data, &residual, 10);
-                            for(int i = 0; i < foreign_table->row_count; i++)
-                            {
-                                int check_int = get_linked_list_data_int(foreign_column->rows, i);
+                    clear_array_list(insert_table->key_buffer);
+                    if(add_key_data(insert_table->key_buffer, column, data, data_len) && is_foreign_key_present(column, insert_table->key_buffer))
+                    {
+                        continue;
+                    }
 
-                                if(check_int == integer)
-                                {
-                                    found_foreign = 1;
-                                    break;
-                                }
-                            }
-                            if(!found_foreign)
-                            {
-                                error = 1;
-                                printf("Cannot find foreign key on target table, value : %i\n", integer);
-                                error_message = "Error when inserting table, cannot find foreign key on target table\n";
-                                goto pass;
-                            }
-                            break;
-                            case FLOAT_TYPE:
-                            float floating = strtof(data, &residual);
-                            for(int i = 0; i < foreign_table->row_count; i++)
-                            {
-                                float check_float = get_linked_list_data_float(foreign_column->rows, i);
-                                if(floating == check_float)
-                                {
-                                    found_foreign = 1;
-                                    break;
-                                }
-                            }
-                            if(!found_foreign)
-                            {
-                                error = 1;
-                                printf("Cannot find foreign key on target table, value : %f\n", floating);
-                                error_message = "Error when inserting table, cannot find foreign key on target table\n";
-                                goto pass;
-                            }
-                            break;
-                            case CHAR_TYPE:
-                            char character = ' ';
-                            if(data_len > 0)
-                            {
-                                character = *(data);
-                            }
-                            for(int i = 0; i < foreign_table->row_count; i++)
-                            {
-                                char check_char = get_linked_list_data_char(foreign_column->rows, i);
-                                if(check_char == character)
-                                {
-                                    found_foreign = 1;
-                                    break;
-                                }
-                            }
-                            if(!found_foreign)
-                            {
-                                error = 1;
-                                printf("Cannot find foreign key on target table, value : %c\n", character);
-                                error_message = "Error when inserting table, cannot find foreign key on target table\n";
-                                goto pass;
-                            }
-                            break;
-                            case VARCHAR_TYPE:
-                            for(int i = 0; i < foreign_table->row_count; i++)
-                            {
-                                char* check_string = get_linked_list_data_string(foreign_column->rows, i);
-                                if(strcmp(check_string, data) == 0)
-                                {
-                                    found_foreign = 1;
-                                    break;
-                                }
-                            }
-                            if(!found_foreign)
-                            {
-                                error = 1;
-                                printf("Cannot find foreign key on target table, value : %s\n", data);
-                                error_message = "Error when inserting table, cannot find foreign key on target table\n";
-                                goto pass;
-                            }
-                            break;
-                        }
+                    error = 1;
+                    switch (column->type)
+                    {
+                        case INT_TYPE:
+                        printf("Cannot find foreign key on target table, value : %i\n", (int)strtol(data, &residual, 10));
+                        break;
+                        case FLOAT_TYPE:
+                        printf("Cannot find foreign key on target table, value : %f\n", strtof(data, &residual));
+                        break;
+                        case CHAR_TYPE:
+                        printf("Cannot find foreign key on target table, value : %c\n", get_char_value(data, data_len));
+                        break;
+                        case VARCHAR_TYPE:
+                        printf("Cannot find foreign key on target table, value : %s\n", data);
+                        break;
                     }
+                    error_message = "Error when inserting table, cannot find foreign key on target table\n";
+                    goto pass;
                 }
 
                 //Insert
+                int insert_row = get_table_insert_row(insert_table);
                 for(int i = 0; i < insert_table->columns->count; i++)
                 {
-                    TABLE_ITEM* column = *((TABLE_ITEM**)get_linked_list_data(insert_table->columns, i));
+                    TABLE_ITEM* column = *((TABLE_ITEM**)get_array_list_data(insert_table->columns, i));
                     char* data = tokens->data[i + 1];
                     int data_len = tokens->size[i + 1];
                     char* residual;
@@ -2195,28 +4811,28 @@ void run()
                     {
                         case INT_TYPE:
                         int integer = strtol(data, &residual, 10);
-                        add_linked_list_int(column->rows, integer);
+                        add_column_int(column, insert_row, integer);
                         break;
                         case FLOAT_TYPE:
                         float floating = strtof(data, &residual);
-                        add_linked_list_float(column->rows, floating);
+                        add_column_float(column, insert_row, floating);
                         break;
                         case CHAR_TYPE:
                         if(data_len < 1)
                         {
-                            add_linked_list_char(column->rows, ' ');
+                            add_column_char(column, insert_row, ' ');
                         }
                         else
                         {
-                            add_linked_list_char(column->rows, *(data));
+                            add_column_char(column, insert_row, *(data));
                         }
                         break;
                         case VARCHAR_TYPE:
-                        add_linked_list_string_safe(column->rows, data);
+                        add_column_string(column, insert_row, data);
                         break;
                     }
                 }
-                insert_table->row_count += 1;
+                commit_table_insert_row(insert_table);
             }
             else if(command_type == END)
             {
@@ -2248,63 +4864,79 @@ void run()
                     goto pass;
                 }
 
-                printf("=======================%s=======================\n", display_table->name);
+                if(display_order->column != NULL && (display_join->left_table != NULL || display_aggregate->is_active))
+                {
+                    error = 1;
+                    error_message = "ORDER BY is not supported on JOIN or aggregates\n";
+                    goto pass;
+                }
 
-                int add_space = 0;
-                for(int i = 0; i < display_column->count; i++)
+                if(display_into != NULL)
                 {
-                    char* column_name = *((char**)get_linked_list_data(display_column, i));
-                    int column_index = get_column_index(display_table, column_name);
-                    if(column_index == -1)
+                    display_file = fopen(display_into, display_sink->format == BINARY_FORMAT ? "wb" : "w");
+                    if(display_file == NULL)
                     {
-                        printf("Error when displaying, cannot find column index of %s", column_name);
+                        error = 1;
+                        printf("Cannot open file : %s\n", display_into);
+                        error_message = "Cannot open file for DISPLAY INTO\n";
+                        goto pass;
                     }
+                    set_result_writer_file(output, display_file);
+                    display_into = NULL;
+                }
 
-                    TABLE_ITEM* table_item = *((TABLE_ITEM**)get_linked_list_data(display_table->columns, column_index));
-                    if(add_space)
-                    {
-                        printf(" | ");
-                    }
-                    printf("%s", table_item->name);
-                    add_space = 1;
+                if(display_join->left_table != NULL)
+                {
+                    display_join_rows(display_join, scan, display_order, display_sink);
+                    end_display_join(display_join);
+                }
+                else if(display_aggregate->is_active)
+                {
+                    display_aggregate_rows(display_aggregate, scan, display_table, logics, display_order, display_sink);
+                    end_display_aggregate(display_aggregate);
                 }
-                printf("\n");
-                for(int i = 0; i < display_table->row_count; i++)
+                else
                 {
-                    add_space = 0;
-                    if(is_true_on_logics(logics, display_table, i))
+                    TABLE_ITEM** columns = (TABLE_ITEM**)display_columns->data;
+                    int column_count = display_columns->count;
+
+                    write_display_title(display_sink, display_table, NULL);
+                    for(int i = 0; i < column_count; i++)
+                    {
+                        add_result_column(display_sink, NULL, (*(columns + i))->name, get_column_result_type(*(columns + i)));
+                    }
+                    begin_result_rows(display_sink);
+                    if(display_order->column != NULL)
                     {
-                        for(int j = 0; j < display_column->count; j++)
+                        collect_ordered_rows(display_order, scan, display_table, logics);
+                        for(int i = display_order->offset; i < display_order->rows->count; i++)
                         {
-                            char* column_name = *((char**)get_linked_list_data(display_column, j));
-                            int column_index = get_column_index(display_table, column_name);
-
-                            if(add_space)
-                            {
-                                printf(" | ");
-                            }
-                            TABLE_ITEM* table_item = *((TABLE_ITEM**)get_linked_list_data(display_table->columns, column_index));
-                            if(table_item->type == INT_TYPE)
-                            {
-                                printf("%i", get_linked_list_data_int(table_item->rows, i));
-                            }
-                            else if(table_item->type == FLOAT_TYPE)
-                            {
-                                printf("%f", get_linked_list_data_float(table_item->rows, i));   
-                            }
-                            else if(table_item->type == CHAR_TYPE)
-                            {
-                                printf("%c", get_linked_list_data_char(table_item->rows, i));   
-                            }
-                            else if(table_item->type == VARCHAR_TYPE)
+                            write_display_row(display_sink, columns, column_count, get_array_list_data_int(display_order->rows, i));
+                        }
+                    }
+                    else
+                    {
+                        //Without ORDER BY the scan stops as soon as the LIMIT is reached
+                        long long end = display_order->limit == -1 ? -1 : (long long)display_order->offset + display_order->limit;
+                        long long position = 0;
+                        for(int i = begin_row_scan(scan, display_table, logics); i != -1 && position != end; i = next_row_scan(scan), position++)
+                        {
+                            if(position >= display_order->offset)
                             {
-                                printf("%s", get_linked_list_data_string(table_item->rows, i));   
+                                write_display_row(display_sink, columns, column_count, i);
                             }
-                            add_space = 1;
                         }
-                        printf("\n");
                     }
                 }
+                finish_result(display_sink);
+                if(display_file != NULL)
+                {
+                    set_result_writer_file(output, stdout);
+                    fclose(display_file);
+                    display_file = NULL;
+                }
+                display_sink->format = TEXT_FORMAT;
+                end_display_order(display_order);
                 for(int i = 0; i < logics->count; i++)
                 {
                     LOGIC_ITEM* logic_item = *((LOGIC_ITEM**)get_linked_list_data(logics, i));
@@ -2312,7 +4944,7 @@ void run()
                     free_logic(logic_item);
                 }
                 clear_linked_list(logics);
-                clear_linked_list(display_column);
+                clear_array_list(display_columns);
 
                 input_type = EMPTY;
             }
@@ -2325,9 +4957,131 @@ void run()
                     goto pass;
                 }
 
-                LOGIC_ITEM* logic_item = create_logic_item(display_table, tokens->data[1], tokens->data[2], tokens->size[2], tokens->data[3], tokens->size[3]);
+                if(display_join->left_table != NULL)
+                {
+                    add_join_logic(display_join, statement_memory, tokens);
+                    goto pass;
+                }
+
+                LOGIC_ITEM* logic_item = create_logic_item(statement_memory, display_table, tokens->data[1], tokens->data[2], tokens->size[2], tokens->data[3], tokens->size[3]);
                 add_linked_list_value(logics, &logic_item);
             }
+            else if(command_type == ORDER)
+            {
+                if(tokens->length < 3 || tokens->length > 4 || strcmp(tokens->data[1], BY_COMMAND) != 0)
+                {
+                    error = 1;
+                    error_message = "Sytax error when ORDER BY on DISPLAY\n";
+                    goto pass;
+                }
+                if(tokens->length == 4 && strcmp(tokens->data[3], ASC_COMMAND) != 0 && strcmp(tokens->data[3], DESC_COMMAND) != 0)
+                {
+                    error = 1;
+                    error_message = "ORDER BY direction has to be ASC or DESC\n";
+                    goto pass;
+                }
+                int column_index = get_column_index(display_table, tokens->data[2]);
+                if(column_index == -1)
+                {
+                    error = 1;
+                    printf("Cannot find column : %s\n", tokens->data[2]);
+                    error_message = "Cannot find column for ORDER BY\n";
+                    goto pass;
+                }
+
+                display_order->column = *((TABLE_ITEM**)get_array_list_data(display_table->columns, column_index));
+                display_order->is_descending = tokens->length == 4 && strcmp(tokens->data[3], DESC_COMMAND) == 0;
+            }
+            else if(command_type == FORMAT)
+            {
+                if(tokens->length != 2 && (tokens->length != 4 || strcmp(tokens->data[2], INTO_COMMAND) != 0))
+                {
+                    error = 1;
+                    error_message = "Sytax error when FORMAT on DISPLAY\n";
+                    goto pass;
+                }
+
+                if(strcmp(tokens->data[1], TEXT_COMMAND) == 0)
+                {
+                    display_sink->format = TEXT_FORMAT;
+                }
+                else if(strcmp(tokens->data[1], CSV_COMMAND) == 0)
+                {
+                    display_sink->format = CSV_FORMAT;
+                }
+                else if(strcmp(tokens->data[1], JSONL_COMMAND) == 0)
+                {
+                    display_sink->format = JSONL_FORMAT;
+                }
+                else if(strcmp(tokens->data[1], BINARY_COMMAND) == 0)
+                {
+                    display_sink->format = BINARY_FORMAT;
+                }
+                else
+                {
+                    error = 1;
+                    printf("Unknown format : %s\n", tokens->data[1]);
+                    error_message = "Unknown FORMAT for DISPLAY\n";
+                    goto pass;
+                }
+
+                //Binary output is only written to files, the console would mangle it
+                if(display_sink->format == BINARY_FORMAT && tokens->length != 4)
+                {
+                    error = 1;
+                    error_message = "FORMAT BINARY needs INTO a file\n";
+                    goto pass;
+                }
+                display_into = tokens->length == 4 ? copy_arena_string(statement_memory, tokens->data[3], tokens->size[3]) : NULL;
+            }
+            else if(command_type == LIMIT)
+            {
+                if(tokens->length != 2 && (tokens->length != 4 || strcmp(tokens->data[2], OFFSET_COMMAND) != 0))
+                {
+                    error = 1;
+                    error_message = "Sytax error when LIMIT on DISPLAY\n";
+                    goto pass;
+                }
+
+                char* end;
+                display_order->limit = strtol(tokens->data[1], &end, 10);
+                display_order->offset = tokens->length == 4 ? strtol(tokens->data[3], &end, 10) : 0;
+                if(display_order->limit < 0 || display_order->offset < 0)
+                {
+                    error = 1;
+                    error_message = "LIMIT and OFFSET cannot be negative\n";
+                    goto pass;
+                }
+            }
+            else if(command_type == GROUP)
+            {
+                if(tokens->length < 3 || strcmp(tokens->data[1], BY_COMMAND) != 0)
+                {
+                    error = 1;
+                    error_message = "Sytax error when GROUP BY on DISPLAY\n";
+                    goto pass;
+                }
+                if(display_join->left_table != NULL)
+                {
+                    error = 1;
+                    error_message = "GROUP BY is not supported on JOIN\n";
+                    goto pass;
+                }
+
+                //Plain column lists become group columns once grouped
+                if(!display_aggregate->is_active)
+                {
+                    for(int i = 0; i < display_columns->count; i++)
+                    {
+                        add_aggregate_item(display_aggregate, statement_memory, display_table, (*((TABLE_ITEM**)get_array_list_data(display_columns, i)))->name);
+                    }
+                    display_aggregate->is_active = 1;
+                }
+                for(int i = 2; i < tokens->length; i++)
+                {
+                    add_group_column(display_aggregate, display_table, tokens->data[i]);
+                }
+            }
             else
             {
                 error = 1;
@@ -2352,35 +5106,25 @@ void run()
                     goto pass;
                 }
 
-                for(int i = 0; i < delete_table_where->row_count; i++)
+                clear_array_list(delete_rows);
+                for(int i = begin_row_scan(scan, delete_table_where, logics); i != -1; i = next_row_scan(scan))
                 {
-                    if(is_true_on_logics(logics, delete_table_where, i))
+                    if(is_referenced_foreign_to_index(delete_table_where, i))
                     {
-                        if(is_referenced_foreign_to_index(tables, delete_table_where, i))
-                        {
-                            error = 1;
-                            printf("Error when deleting, row index is referenced to foreign\n");
-                            error_message = "Error when deleting, cannot delete a foreign referenced row\n";
-                            goto pass;
-                        }
+                        error = 1;
+                        printf("Error when deleting, row index is referenced to foreign\n");
+                        error_message = "Error when deleting, cannot delete a foreign referenced row\n";
+                        goto pass;
                     }
+                    add_array_list_int(delete_rows, i);
                 }
 
-                int current_index = 0;
-                int current_row_count = delete_table_where->row_count;
-                while (current_index < current_row_count)
+                //Rows are only collected first so a referenced row cancels the whole DELETE
+                for(int i = 0; i < delete_rows->count; i++)
                 {
-                    int index_adder = 1;
-
-                    if(is_true_on_logics(logics, delete_table_where, current_index))
-                    {
-                        delete_table_row(delete_table_where, current_index);
-                        index_adder = 0;
-                    }
-
-                    current_index += index_adder;
-                    current_row_count = delete_table_where->row_count;
+                    delete_table_row(delete_table_where, get_array_list_data_int(delete_rows, i));
                 }
+                vacuum_table_on_threshold(delete_table_where);
                 
                 delete_table_where = NULL;
 
@@ -2403,7 +5147,7 @@ void run()
                     goto pass;
                 }
 
-                LOGIC_ITEM* logic_item = create_logic_item(delete_table_where, tokens->data[1], tokens->data[2], tokens->size[2], tokens->data[3], tokens->size[3]);
+                LOGIC_ITEM* logic_item = create_logic_item(statement_memory, delete_table_where, tokens->data[1], tokens->data[2], tokens->size[2], tokens->data[3], tokens->size[3]);
                 add_linked_list_value(logics, &logic_item);
             }
         }
@@ -2442,17 +5186,16 @@ void run()
 
                 if(current_item == NULL)
                 {
-                    current_item = heapallocate(sizeof(UPDATE_ITEM));
+                    current_item = allocate_arena_memory(statement_memory, sizeof(UPDATE_ITEM));
                     current_item->column_index = column_index;
-                    current_item->data = copy_string(tokens->data[2], tokens->size[2]);
+                    current_item->data = copy_arena_string(statement_memory, tokens->data[2], tokens->size[2]);
                     current_item->data_size = tokens->size[2];
 
                     add_linked_list_value(update_item, &current_item);
                 }
                 else
                 {
-                    free(current_item->data);
-                    current_item->data = copy_string(tokens->data[2], tokens->size[2]);
+                    current_item->data = copy_arena_string(statement_memory, tokens->data[2], tokens->size[2]);
                     current_item->data_size = tokens->size[2];
                 }
             }
@@ -2471,7 +5214,7 @@ void run()
                     goto pass;
                 }
 
-                LOGIC_ITEM* logic_item = create_logic_item(update_table, tokens->data[1], tokens->data[2], tokens->size[2], tokens->data[3], tokens->size[3]);
+                LOGIC_ITEM* logic_item = create_logic_item(statement_memory, update_table, tokens->data[1], tokens->data[2], tokens->size[2], tokens->data[3], tokens->size[3]);
                 add_linked_list_value(logics, &logic_item);
             }
             else if(command_type == END)
@@ -2484,28 +5227,16 @@ void run()
                 }
                 if(update_table_at != -1)
                 {
-                    update_table_column_at(tables, update_table, update_item, update_table_at);
+                    update_table_column_at(update_table, update_item, update_table_at);
                 }
                 else
                 {
-                    for(int i = 0; i < update_table->row_count; i++)
+                    for(int i = begin_row_scan(scan, update_table, logics); i != -1; i = next_row_scan(scan))
                     {
-                        if(!is_true_on_logics(logics, update_table, i))
-                        {
-                            continue;
-                        }
-                        
-                        update_table_column_at(tables, update_table, update_item, i);
+                        update_table_column_at(update_table, update_item, i);
                     }
                 }
 
-                for(int i = 0; i < update_item->count; i++)
-                {
-                    UPDATE_ITEM* current_update = *((UPDATE_ITEM**)get_linked_list_data(update_item, i));
-                    
-                    free(current_update->data);
-                    free(current_update);
-                }
                 for(int i = 0; i < logics->count; i++)
                 {
                     LOGIC_ITEM* logic_item = *((LOGIC_ITEM**)get_linked_list_data(logics, i));
@@ -2529,7 +5260,11 @@ void run()
         }
 
         pass:
-        free_parsedata(tokens);
+        clear_arena(line_memory);
+        if(input_type == EMPTY)
+        {
+            clear_arena(statement_memory);
+        }
 
         if(error)
         {